@@ -0,0 +1,312 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PracticeAIController.h"
+
+#include "EngineUtils.h"
+#include "GameFramework/PlayerStart.h"
+#include "PracticeCharacter.h"
+#include "PracticeGameMode.h"
+#include "Sparta_Practice_7.h"
+
+static FAutoConsoleCommandWithWorldAndArgs PracticeSpawnAICommand(
+	TEXT("practice.SpawnAI"),
+	TEXT("practice.SpawnAI <수> [Wander|Path] [반경] : 플레이어 주변에 AI Pawn을 만든다."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&APracticeAIController::SpawnAIPawns));
+
+static FAutoConsoleCommandWithWorld PracticeClearAICommand(
+	TEXT("practice.ClearAI"),
+	TEXT("practice.SpawnAI로 만든 AI Pawn을 모두 제거한다."),
+	FConsoleCommandWithWorldDelegate::CreateStatic(&APracticeAIController::ClearAIPawns));
+
+APracticeAIController::APracticeAIController()
+{
+	PrimaryActorTick.bCanEverTick = true;
+
+	// 기본값은 Pawn의 방향을 Control Rotation으로 덮어쓴다. 이동 방향은 Control Rotation의 Yaw로 지시하므로 끈다.
+	bSetControlRotationFromPawnOrientation = false;
+
+	Behavior = EPracticeAIBehavior::Idle;
+	WanderRadius = 1500.0f;
+	bLoopPath = true;
+	AcceptanceRadius = 100.0f;
+	TargetTimeout = 5.0f;
+	DecisionInterval = 0.2f;
+	JumpInterval = 0.0f;
+}
+
+void APracticeAIController::OnPossess(APawn* InPawn)
+{
+	Super::OnPossess(InPawn);
+
+	HomeLocation = InPawn->GetActorLocation();
+	Random.Initialize(GetTypeHash(InPawn->GetFName()));
+	bHasTarget = false;
+	DecisionTimeRemaining = 0.0f;
+	JumpTimeRemaining = GetRandomJumpDelay();
+}
+
+void APracticeAIController::OnUnPossess()
+{
+	if (APracticeCharacter* PracticePawn = Cast<APracticeCharacter>(GetPawn()))
+	{
+		PracticePawn->SetMoveInput(FVector2D::ZeroVector);
+	}
+
+	Super::OnUnPossess();
+}
+
+void APracticeAIController::StartWander(const FVector& Origin, float Radius)
+{
+	Behavior = EPracticeAIBehavior::Wander;
+	HomeLocation = Origin;
+	WanderRadius = Radius;
+	bHasTarget = false;
+	DecisionTimeRemaining = 0.0f;
+}
+
+void APracticeAIController::StartFollowPath(const TArray<FVector>& Points, bool bLoop)
+{
+	Behavior = EPracticeAIBehavior::FollowPath;
+	PathPoints = Points;
+	bLoopPath = bLoop;
+	PathIndex = 0;
+	bHasTarget = false;
+	DecisionTimeRemaining = 0.0f;
+}
+
+void APracticeAIController::StopBehavior()
+{
+	Behavior = EPracticeAIBehavior::Idle;
+	bHasTarget = false;
+	if (APracticeCharacter* PracticePawn = Cast<APracticeCharacter>(GetPawn()))
+	{
+		PracticePawn->SetMoveInput(FVector2D::ZeroVector);
+	}
+}
+
+void APracticeAIController::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Behavior == EPracticeAIBehavior::Idle || !GetPawn())
+	{
+		return;
+	}
+
+	TargetTimeRemaining -= DeltaTime;
+	DecisionTimeRemaining -= DeltaTime;
+	if (DecisionTimeRemaining <= 0.0f)
+	{
+		DecisionTimeRemaining = DecisionInterval;
+		Decide();
+	}
+
+	if (JumpInterval > 0.0f)
+	{
+		JumpTimeRemaining -= DeltaTime;
+		if (JumpTimeRemaining <= 0.0f)
+		{
+			JumpTimeRemaining = GetRandomJumpDelay();
+			if (APracticeCharacter* PracticePawn = Cast<APracticeCharacter>(GetPawn()))
+			{
+				PracticePawn->RequestJump();
+			}
+		}
+	}
+}
+
+void APracticeAIController::Decide()
+{
+	APracticeCharacter* PracticePawn = Cast<APracticeCharacter>(GetPawn());
+	if (!PracticePawn)
+	{
+		return;
+	}
+
+	const FVector PawnLocation = PracticePawn->GetActorLocation();
+	const bool bArrived = bHasTarget && FVector::DistSquared2D(PawnLocation, TargetLocation) <= FMath::Square(AcceptanceRadius);
+	if (!bHasTarget || bArrived || TargetTimeRemaining <= 0.0f)
+	{
+		bHasTarget = PickNextTarget();
+		TargetTimeRemaining = TargetTimeout;
+	}
+
+	if (!bHasTarget)
+	{
+		PracticePawn->SetMoveInput(FVector2D::ZeroVector);
+		return;
+	}
+
+	// 플레이어와 같이 Controller의 Yaw를 목표 방향으로 돌리고 앞으로 이동 입력을 넣는다.
+	const FVector ToTarget = TargetLocation - PawnLocation;
+	FRotator NewControlRotation = GetControlRotation();
+	NewControlRotation.Yaw = FMath::RadiansToDegrees(FMath::Atan2(ToTarget.Y, ToTarget.X));
+	SetControlRotation(NewControlRotation);
+	PracticePawn->SetMoveInput(FVector2D(1.0f, 0.0f));
+}
+
+bool APracticeAIController::PickNextTarget()
+{
+	switch (Behavior)
+	{
+	case EPracticeAIBehavior::Wander:
+	{
+		const FVector2D Offset = FVector2D(Random.VRand()).GetSafeNormal() * Random.FRandRange(0.0f, WanderRadius);
+		TargetLocation = HomeLocation + FVector(Offset, 0.0f);
+		return true;
+	}
+	case EPracticeAIBehavior::FollowPath:
+	{
+		if (PathPoints.IsEmpty())
+		{
+			return false;
+		}
+		if (bHasTarget)
+		{
+			++PathIndex;
+		}
+		if (PathIndex >= PathPoints.Num())
+		{
+			if (!bLoopPath)
+			{
+				Behavior = EPracticeAIBehavior::Idle;
+				return false;
+			}
+			PathIndex = 0;
+		}
+		TargetLocation = PathPoints[PathIndex];
+		return true;
+	}
+	case EPracticeAIBehavior::Idle:
+	default:
+		return false;
+	}
+}
+
+float APracticeAIController::GetRandomJumpDelay()
+{
+	return JumpInterval * Random.FRandRange(0.5f, 1.5f);
+}
+
+void APracticeAIController::SpawnAIPawns(const TArray<FString>& Args, UWorld* World)
+{
+	// Pawn 생성과 이동은 서버에서만 처리한다.
+	AGameModeBase* GameMode = World ? World->GetAuthGameMode() : nullptr;
+	if (!GameMode)
+	{
+		UE_LOG(LogPracticeMovement, Warning, TEXT("practice.SpawnAI : requires authority (server or standalone)"));
+		return;
+	}
+
+	const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1;
+	const bool bFollowPath = Args.Num() > 1 && Args[1].Equals(TEXT("Path"), ESearchCase::IgnoreCase);
+	const float Radius = Args.Num() > 2 ? FCString::Atof(*Args[2]) : 1500.0f;
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	// 첫 번째 플레이어의 Pawn 혹은 PlayerStart 주변에 만든다.
+	FVector Origin = FVector(0.0f, 0.0f, 200.0f);
+	if (const APlayerController* PlayerController = World->GetFirstPlayerController(); PlayerController && PlayerController->GetPawn())
+	{
+		Origin = PlayerController->GetPawn()->GetActorLocation();
+	}
+	else
+	{
+		for (TActorIterator<APlayerStart> It(World); It; ++It)
+		{
+			Origin = It->GetActorLocation();
+			break;
+		}
+	}
+
+	APracticeGameMode* PracticeGameMode = Cast<APracticeGameMode>(GameMode);
+	FRandomStream SpawnRandom(Count);
+	int32 NumSpawned = 0;
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		const FVector2D Offset = FVector2D(SpawnRandom.VRand()).GetSafeNormal() * SpawnRandom.FRandRange(200.0f, Radius);
+		const FTransform SpawnTransform(FRotator(0.0f, SpawnRandom.FRandRange(-180.0f, 180.0f), 0.0f), Origin + FVector(Offset, 0.0f));
+
+		APracticeCharacter* Pawn = nullptr;
+		if (PracticeGameMode)
+		{
+			Pawn = PracticeGameMode->AcquirePawn(SpawnTransform);
+		}
+		else
+		{
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			Pawn = World->SpawnActor<APracticeCharacter>(APracticeCharacter::StaticClass(), SpawnTransform, SpawnParams);
+		}
+		if (!Pawn)
+		{
+			continue;
+		}
+
+		APracticeAIController* AIController = World->SpawnActor<APracticeAIController>(SpawnTransform.GetLocation(), SpawnTransform.Rotator());
+		if (!AIController)
+		{
+			continue;
+		}
+		AIController->bSpawnedByCommand = true;
+		AIController->JumpInterval = 4.0f;
+		AIController->Possess(Pawn);
+
+		if (bFollowPath)
+		{
+			// 시작 위치를 꼭짓점으로 하는 사각형 경로
+			const FVector Start = Pawn->GetActorLocation();
+			const FVector Forward = Pawn->GetActorForwardVector() * 800.0f;
+			const FVector Right = Pawn->GetActorRightVector() * 800.0f;
+			AIController->StartFollowPath({ Start + Forward, Start + Forward + Right, Start + Right, Start }, true);
+		}
+		else
+		{
+			AIController->StartWander(Pawn->GetActorLocation(), AIController->WanderRadius);
+		}
+		++NumSpawned;
+	}
+
+	UE_LOG(LogPracticeMovement, Log, TEXT("practice.SpawnAI : %d pawns (%s)"), NumSpawned, bFollowPath ? TEXT("Path") : TEXT("Wander"));
+}
+
+void APracticeAIController::ClearAIPawns(UWorld* World)
+{
+	if (!World || !World->GetAuthGameMode())
+	{
+		return;
+	}
+
+	APracticeGameMode* PracticeGameMode = Cast<APracticeGameMode>(World->GetAuthGameMode());
+	TArray<APracticeAIController*> Controllers;
+	for (TActorIterator<APracticeAIController> It(World); It; ++It)
+	{
+		if (It->bSpawnedByCommand)
+		{
+			Controllers.Add(*It);
+		}
+	}
+
+	for (APracticeAIController* AIController : Controllers)
+	{
+		APracticeCharacter* Pawn = Cast<APracticeCharacter>(AIController->GetPawn());
+		AIController->UnPossess();
+		if (Pawn)
+		{
+			if (PracticeGameMode)
+			{
+				PracticeGameMode->ReleasePawn(Pawn);
+			}
+			else
+			{
+				Pawn->Destroy();
+			}
+		}
+		AIController->Destroy();
+	}
+
+	UE_LOG(LogPracticeMovement, Log, TEXT("practice.ClearAI : %d pawns"), Controllers.Num());
+}
@@ -0,0 +1,29 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PracticeCameraManager.h"
+
+#include "PracticeCharacter.h"
+
+static TAutoConsoleVariable<int32> CVarPracticeCameraLateUpdate(
+	TEXT("practice.Camera.LateUpdate"),
+	1,
+	TEXT("플레이어 Pawn의 Camera를 Pawn Tick 대신 Camera Manager에서 프레임 마지막에 갱신한다.\n")
+	TEXT("0: Pawn Tick에서 갱신, 1: Camera Manager에서 갱신"),
+	ECVF_Default);
+
+void APracticeCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime)
+{
+	// Camera Component의 View를 읽기 전에 이번 프레임의 최종 회전, 위치를 적용한다.
+	if (APracticeCharacter* PracticeCharacter = Cast<APracticeCharacter>(OutVT.Target))
+	{
+		const bool bLateUpdate = CVarPracticeCameraLateUpdate.GetValueOnGameThread() != 0;
+		PracticeCharacter->SetLateCameraUpdate(bLateUpdate);
+		if (bLateUpdate)
+		{
+			PracticeCharacter->UpdateCameraLate(DeltaTime);
+		}
+	}
+
+	Super::UpdateViewTarget(OutVT, DeltaTime);
+}
@@ -5,10 +5,97 @@
 
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
-#include "GameFramework/SpringArmComponent.h"
 #include "EnhancedInputComponent.h"
+#include "Engine/DamageEvents.h"
+#include "Engine/NetConnection.h"
+#include "Net/UnrealNetwork.h"
 #include "MathUtil.h"
+#include "VisualLogger/VisualLogger.h"
+#include "PracticeAIController.h"
 #include "PracticeController.h"
+#include "PracticeGroundCacheSubsystem.h"
+#include "PracticeGroundProbeSubsystem.h"
+#include "PracticeInputRecording.h"
+#include "PracticeMovementBaseSubsystem.h"
+#include "PracticeMovementProfiler.h"
+#include "PracticeMovementStats.h"
+#include "PracticeMovementSubsystem.h"
+#include "PracticeSeparationSubsystem.h"
+#include "PracticeSignificanceSubsystem.h"
+#include "PracticeSpringArmComponent.h"
+#include "Sparta_Practice_7.h"
+
+DEFINE_STAT(STAT_PracticeFixedSubSteps);
+DEFINE_STAT(STAT_PracticeMoveSweeps);
+DEFINE_STAT(STAT_PracticeUpdateControllerRotation);
+DEFINE_STAT(STAT_PracticePlaneMove);
+DEFINE_STAT(STAT_PracticeAirPlaneMove);
+DEFINE_STAT(STAT_PracticeHorizontalSweep);
+DEFINE_STAT(STAT_PracticeVerticalSweep);
+DEFINE_STAT(STAT_PracticeIsOnGround);
+DEFINE_STAT(STAT_PracticeUpdateCamera);
+DEFINE_STAT(STAT_PracticeActiveCameraRigs);
+DEFINE_STAT(STAT_PracticeLandings);
+DEFINE_STAT(STAT_PracticeMovementTimerStarts);
+DEFINE_STAT(STAT_PracticeBufferedJumps);
+DEFINE_STAT(STAT_PracticeCoyoteJumps);
+DEFINE_STAT(STAT_PracticeNetMoves);
+DEFINE_STAT(STAT_PracticeNetCorrections);
+DEFINE_STAT(STAT_PracticeNetRejectedMoves);
+DEFINE_STAT(STAT_PracticeSleepingPawns);
+DEFINE_STAT(STAT_PracticeAwakePawns);
+DEFINE_STAT(STAT_PracticePawnWakes);
+
+static TAutoConsoleVariable<int32> CVarPracticeSleepEnable(
+	TEXT("practice.Sleep.Enable"),
+	1,
+	TEXT("입력과 속도 없이 지면에 서 있는 Pawn의 Tick을 끈다.\n")
+	TEXT("0: 항상 Tick, 1: 정지 상태가 SleepDelay 동안 이어지면 Sleep"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPracticeNetMaxLocationError(
+	TEXT("practice.Net.MaxLocationError"),
+	5.0f,
+	TEXT("서버 이동 결과와 클라이언트 위치가 이 거리 이상 다르면 보정한다."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarPracticeNetMaxSavedMoves(
+	TEXT("practice.Net.MaxSavedMoves"),
+	96,
+	TEXT("클라이언트가 서버 확인을 기다리며 저장하는 최대 입력 수"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPracticeNetMaxMoveTimeBudget(
+	TEXT("practice.Net.MaxMoveTimeBudget"),
+	0.5f,
+	TEXT("서버가 클라이언트 입력에 쓸 수 있도록 쌓아 두는 최대 시간(초)\n")
+	TEXT("서버 시간만큼 쌓이고 입력의 DeltaTime만큼 쓴다. 남은 시간보다 긴 입력은 거절한다."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarPracticeNetReport(
+	TEXT("practice.Net.Report"),
+	0,
+	TEXT("서버에서 클라이언트별 초당 송수신 Byte와 보정 비율을 1초마다 출력한다."),
+	ECVF_Default);
+
+#if CPUPROFILERTRACE_ENABLED && !UE_BUILD_SHIPPING
+UE_TRACE_CHANNEL_DEFINE(PracticeMovementChannel);
+#endif
+
+#if !UE_BUILD_SHIPPING
+static TAutoConsoleVariable<int32> CVarPracticeMovementDebugSlide(
+	TEXT("practice.Movement.DebugSlide"),
+	0,
+	TEXT("수평 이동 충돌(경사각) 요약을 출력한다.\n")
+	TEXT("0: 끄기, 1: LogPracticeMovement, 2: + 화면 출력, 3: + Visual Logger에 충돌 법선 기록"),
+	ECVF_Cheat);
+
+static TAutoConsoleVariable<float> CVarPracticeMovementDebugSlideInterval(
+	TEXT("practice.Movement.DebugSlideInterval"),
+	1.0f,
+	TEXT("수평 이동 충돌 요약 출력 간격(초)"),
+	ECVF_Cheat);
+#endif
 
 // Sets default values
 APracticeCharacter::APracticeCharacter()
@@ -16,6 +103,13 @@ APracticeCharacter::APracticeCharacter()
  	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
 
+	// 이동은 ServerMove / NetMovement로 직접 복제한다.
+	bReplicates = true;
+	SetReplicatingMovement(false);
+
+	// SpawnDefaultController로 만들어지는 AI도 같은 입력 경로를 사용한다.
+	AIControllerClass = APracticeAIController::StaticClass();
+
 	CapsuleComponent = CreateDefaultSubobject<UCapsuleComponent>(TEXT("Capsule"));
 	CapsuleComponent->SetCapsuleSize(34.0f, 88.0f);
 	CapsuleComponent->SetCollisionProfileName(UCollisionProfile::Pawn_ProfileName);
@@ -24,7 +118,7 @@ APracticeCharacter::APracticeCharacter()
 	MeshComponent = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("Mesh"));
 	MeshComponent->SetupAttachment(CapsuleComponent);
 
-	SpringArmComponent = CreateDefaultSubobject<USpringArmComponent>(TEXT("SpringArm"));
+	SpringArmComponent = CreateDefaultSubobject<UPracticeSpringArmComponent>(TEXT("SpringArm"));
 	SpringArmComponent->TargetArmLength = 300.0f;
 	SpringArmComponent->SetupAttachment(CapsuleComponent);
 
@@ -40,18 +134,46 @@ APracticeCharacter::APracticeCharacter()
 	FallMultiplier = 1.5f;
 	TerminalSpeed = -2500.0f;
 	LandingLockTime = 0.1f;
+	// 점프 보조 시간은 기존 점프 감각을 바꾸므로 기본으로 끄고 Asset마다 켠다.
+	JumpBufferTime = 0.0f;
+	CoyoteTime = 0.0f;
 	Gravity = -981.0f;
 	GroundCheckDistance = 1.0f;
 	AirSpeedMultiplier = 0.2f;
+	AllowedSlopeAngle = 45.0f;
+	StepHeight = 45.0f;
+	MaxSlideIterations = 3;
 	FallSpeed = 0.0f;
+	MovementMode = EPracticeMovementMode::Walking;
+	StateTimeRemaining = 0.0f;
 	bIsFall = false;
 	bIsJumping = false;
 	bIsLanding = false;
 	bApplyGravity = true;
+	bUseBatchedMovement = false;
+	bCanSleep = true;
+	SleepDelay = 0.5f;
+
+	bUseFixedTimestep = false;
+	FixedStepRate = 60.0f;
+	MaxSubSteps = 4;
 	
-	MouseXSensitive = 180.0f;
-	MouseYSensitive = 180.0f;
+	IsDrone = false;
+	DroneThrust = 2000.0f;
+	DroneDrag = 2.0f;
+	DroneMaxSpeed = 1200.0f;
+	DroneRollSpeed = 90.0f;
+	DroneVelocity = FVector::ZeroVector;
+	DroneThrustInput = 0.0f;
+
+	// 이전의 초당 180도 감도를 60 FPS에서 같은 느낌이 되도록 이동량 기준으로 바꾼 값
+	MouseXSensitive = 3.0f;
+	MouseYSensitive = 3.0f;
 	MaxControllerRotation = FRotator(180.0f, 180.0f, 180.0f);
+	MinViewPitch = -80.0f;
+	MaxViewPitch = 80.0f;
+	LookSmoothingTime = 0.0f;
+	bAlwaysUseCameraRig = false;
 }
 
 // Called when the game starts or when spawned
@@ -60,14 +182,183 @@ void APracticeCharacter::BeginPlay()
 	Super::BeginPlay();
 
 	// 초기 공중 상태 결정
-	if (IsOnGround())
+	// 시작 상태이므로 Enter / Exit 없이 바로 설정한다.
+	MovementMode = IsOnGround(false) ? EPracticeMovementMode::Walking : EPracticeMovementMode::Falling;
+	UpdateMovementModeFlags();
+
+	// 고정 시간 간격 보간에 사용할 기준 Transform
+	PrevSimulationTransform = GetActorTransform();
+	MeshRelativeTransform = MeshComponent->GetRelativeTransform();
+	SpringArmRelativeLocation = SpringArmComponent->GetRelativeLocation();
+
+	// 위치를 기록한 후에 Camera Rig를 정리한다.
+	INC_DWORD_STAT(STAT_PracticeActiveCameraRigs);
+	UpdateCameraRig();
+
+	RegisterMovement();
+}
+
+void APracticeCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UnregisterMovement();
+	SetCameraRigActive(false);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void APracticeCharacter::RegisterMovement()
+{
+	// 배치 이동을 사용할 경우 Subsystem에 상태를 넘기고 개별 Tick을 끈다.
+	// 클라이언트의 Pawn은 네트워크 이동을 사용하므로 서버에서만 사용한다.
+	RegisterBatchedMovement();
+
+	if (UPracticeSignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UPracticeSignificanceSubsystem>())
 	{
-		bIsFall = false;
+		SignificanceSubsystem->RegisterPawn(this);
 	}
-	else
+
+	if (UPracticeSeparationSubsystem* SeparationSubsystem = GetWorld()->GetSubsystem<UPracticeSeparationSubsystem>())
+	{
+		SeparationSubsystem->RegisterPawn(this);
+	}
+}
+
+void APracticeCharacter::RegisterBatchedMovement()
+{
+	if (bUseBatchedMovement && HasAuthority() && !IsBatchedMovement())
+	{
+		if (UPracticeMovementSubsystem* MovementSubsystem = GetWorld()->GetSubsystem<UPracticeMovementSubsystem>())
+		{
+			BatchedMovementIndex = MovementSubsystem->RegisterPawn(this);
+			SetActorTickEnabled(false);
+		}
+	}
+}
+
+void APracticeCharacter::UnregisterMovement()
+{
+	// Sleep 통계와 발밑 Component의 Delegate를 정리한다. Tick은 호출한 쪽에서 다시 정한다.
+	WakeUp();
+	SetMovementBase(nullptr);
+
+	if (UPracticeMovementSubsystem* MovementSubsystem = GetBatchedMovementSubsystem())
+	{
+		MovementSubsystem->UnregisterPawn(this);
+	}
+
+	if (UPracticeGroundProbeSubsystem* GroundProbeSubsystem = GetWorld()->GetSubsystem<UPracticeGroundProbeSubsystem>())
+	{
+		GroundProbeSubsystem->Forget(this);
+	}
+
+	if (UPracticeSignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UPracticeSignificanceSubsystem>())
+	{
+		SignificanceSubsystem->UnregisterPawn(this);
+	}
+
+	if (UPracticeSeparationSubsystem* SeparationSubsystem = GetWorld()->GetSubsystem<UPracticeSeparationSubsystem>())
+	{
+		SeparationSubsystem->UnregisterPawn(this);
+	}
+}
+
+void APracticeCharacter::DeactivateForPool(const FVector& ParkingLocation)
+{
+	if (bIsPooled)
+	{
+		return;
+	}
+	bIsPooled = true;
+
+	UnregisterMovement();
+	ResetMovementState();
+
+	SetActorTickEnabled(false);
+	SetActorEnableCollision(false);
+	SetActorHiddenInGame(true);
+	MeshComponent->SetComponentTickEnabled(false);
+	SetCameraRigActive(false);
+	SetActorLocation(ParkingLocation, false, nullptr, ETeleportType::ResetPhysics);
+}
+
+void APracticeCharacter::ActivateFromPool(const FTransform& SpawnTransform)
+{
+	if (!bIsPooled)
+	{
+		return;
+	}
+	bIsPooled = false;
+
+	ResetMovementState();
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorEnableCollision(true);
+	SetActorHiddenInGame(false);
+	MeshComponent->SetComponentTickEnabled(true);
+
+	// BeginPlay와 같이 시작 상태를 정하고 Subsystem에 다시 등록한다.
+	MovementMode = IsOnGround(false) ? EPracticeMovementMode::Walking : EPracticeMovementMode::Falling;
+	UpdateMovementModeFlags();
+	PrevSimulationTransform = GetActorTransform();
+
+	SetActorTickEnabled(true);
+	RegisterMovement();
+	UpdateCameraRig();
+}
+
+void APracticeCharacter::ResetMovementState()
+{
+	WakeUp();
+	SetMovementBase(nullptr);
+
+	// 드론 상태에서 반환되었으면 지상 이동의 회전으로 먼저 되돌린다.
+	if (MovementMode == EPracticeMovementMode::Drone)
+	{
+		ExitDrone();
+	}
+
+	InputDirection = FVector2D::ZeroVector;
+	LastMovementDirection = FVector2D::ZeroVector;
+	Velocity = 0.0f;
+	MoveDirection = FVector::ZeroVector;
+	FallSpeed = 0.0f;
+	MovementMode = EPracticeMovementMode::Walking;
+	StateTimeRemaining = 0.0f;
+	MovementTimers.Reset();
+	DroneVelocity = FVector::ZeroVector;
+	DroneThrustInput = 0.0f;
+	PendingInputButtons = 0;
+	UpdateMovementModeFlags();
+
+	DeltaCameraRotator = FRotator::ZeroRotator;
+	LookSmoothingRemainder = FRotator::ZeroRotator;
+	SimulationAccumulator = 0.0f;
+	MeshComponent->SetRelativeTransform(MeshRelativeTransform);
+	if (bCameraRigActive)
+	{
+		SpringArmComponent->SetRelativeLocation(SpringArmRelativeLocation);
+	}
+
+	SavedMoves.Reset();
+	ClientTimeStamp = 0;
+	ClientAckedTimeStamp = 0;
+	ClientTimeRemainder = 0.0f;
+	ServerTimeStamp = 0;
+	ServerMoveTimeBudget = 0.0f;
+	ServerMoveBudgetTime = -1.0;
+
+	Significance = EPracticeSignificance::Near;
+	SetActorTickInterval(0.0f);
+	MeshComponent->SetComponentTickInterval(0.0f);
+}
+
+UPracticeMovementSubsystem* APracticeCharacter::GetBatchedMovementSubsystem() const
+{
+	if (!IsBatchedMovement())
 	{
-		bIsFall = true;
+		return nullptr;
 	}
+	const UWorld* World = GetWorld();
+	return World ? World->GetSubsystem<UPracticeMovementSubsystem>() : nullptr;
 }
 
 void APracticeCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -117,6 +408,42 @@ void APracticeCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputC
 					&APracticeCharacter::StartJumpInput
 				);
 			}
+
+			if (PracticeController->DroneToggleAction)
+			{
+				EnhancedInputComponent->BindAction(
+					PracticeController->DroneToggleAction,
+					ETriggerEvent::Started,
+					this,
+					&APracticeCharacter::DroneToggleInput
+				);
+			}
+
+			if (PracticeController->DroneThrustAction)
+			{
+				EnhancedInputComponent->BindAction(
+					PracticeController->DroneThrustAction,
+					ETriggerEvent::Triggered,
+					this,
+					&APracticeCharacter::DroneThrustInputChanged
+				);
+				EnhancedInputComponent->BindAction(
+					PracticeController->DroneThrustAction,
+					ETriggerEvent::Completed,
+					this,
+					&APracticeCharacter::DroneThrustInputChanged
+				);
+			}
+
+			if (PracticeController->DroneRollAction)
+			{
+				EnhancedInputComponent->BindAction(
+					PracticeController->DroneRollAction,
+					ETriggerEvent::Triggered,
+					this,
+					&APracticeCharacter::DroneRollInput
+				);
+			}
 		}
 	}
 }
@@ -124,8 +451,7 @@ void APracticeCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputC
 void APracticeCharacter::MoveInput(const FInputActionValue& Value)
 {
 	// Trigger, Completed를 처리해서 항상 현재 이동 방향을 가지고 있다.
-	// X축 : Forward, Y축 : Right
-	InputDirection = Value.Get<FVector2D>().GetSafeNormal();
+	SetMoveInput(Value.Get<FVector2D>());
 }
 
 void APracticeCharacter::LookInput(const FInputActionValue& Value)
@@ -134,15 +460,75 @@ void APracticeCharacter::LookInput(const FInputActionValue& Value)
 	// 카메라가 바닥으로 내려가면(위를 보게 되면) +90
 	// Y를 일단은 반전시키지 않고 바로 적용하기로 한다.
 	// Y : Pitch, X : Yaw
-	const FVector2D LookDirection = Value.Get<FVector2D>();
-	AddControllerRotation(LookDirection.Y, LookDirection.X, 0.0f);
+	AddLookInput(Value.Get<FVector2D>());
+}
+
+void APracticeCharacter::AddLookInput(const FVector2D& LookDelta)
+{
+	// 콜백마다 더하기만 하고 계산은 UpdateControllerRotation에서 프레임에 한 번 한다.
+	if (LookInputCycles == 0 && !LookDelta.IsZero())
+	{
+		LookInputCycles = FPlatformTime::Cycles64();
+	}
+	AddControllerRotation(LookDelta.Y, LookDelta.X, 0.0f);
+}
+
+void APracticeCharacter::DroneToggleInput(const FInputActionValue& Value)
+{
+	PendingInputButtons |= EPracticeInputButtons::DroneToggle;
+	RequestToggleDrone();
+}
+
+void APracticeCharacter::RequestToggleDrone()
+{
+	WakeUp();
+
+	// 배치 이동에서는 다음 이동 처리에서 전환한다.
+	if (UPracticeMovementSubsystem* MovementSubsystem = GetBatchedMovementSubsystem())
+	{
+		MovementSubsystem->RequestToggleDrone(BatchedMovementIndex);
+		return;
+	}
+
+	// 클라이언트 예측에서는 다음 이동 입력에 담아서 서버와 같은 순서로 처리한다.
+	if (GetLocalRole() == ROLE_AutonomousProxy)
+	{
+		PendingInputButtons |= EPracticeInputButtons::DroneToggle;
+		return;
+	}
+
+	HandleMovementEvent(EPracticeMovementEvent::ToggleDrone);
+}
+
+void APracticeCharacter::DroneThrustInputChanged(const FInputActionValue& Value)
+{
+	// Trigger, Completed를 처리해서 항상 현재 상승 입력을 가지고 있다.
+	SetDroneThrustInput(Value.Get<float>());
+}
+
+void APracticeCharacter::SetDroneThrustInput(float NewThrustInput)
+{
+	DroneThrustInput = FMath::Clamp(NewThrustInput, -1.0f, 1.0f);
+	if (DroneThrustInput != 0.0f)
+	{
+		WakeUp();
+	}
+}
+
+void APracticeCharacter::DroneRollInput(const FInputActionValue& Value)
+{
+	if (MovementMode == EPracticeMovementMode::Drone)
+	{
+		// UpdateControllerRotation에서 DeltaTime을 곱한다.
+		AddControllerRotation(0.0f, 0.0f, Value.Get<float>() * DroneRollSpeed);
+	}
 }
 
 void APracticeCharacter::Jump()
 {
+	// Jumping 상태의 Enter
 	Velocity = FMath::Clamp(Velocity, 0.f, MaxJumpHorizontalVelocity);
 	
-	bIsJumping = true;
 	FallSpeed = JumpVelocity;
 
 	FaceDirection(GetMoveDirectionFromController());
@@ -150,15 +536,114 @@ void APracticeCharacter::Jump()
 
 void APracticeCharacter::StartJumpInput(const FInputActionValue& Value)
 {
-	if (!bIsFall && !bIsLanding)
+	PendingInputButtons |= EPracticeInputButtons::Jump;
+	RequestJump();
+}
+
+FPracticeMovementSnapshot APracticeCharacter::GetMovementSnapshot() const
+{
+	FPracticeMovementSnapshot Snapshot;
+	Snapshot.Location = GetActorLocation();
+	Snapshot.Rotation = GetActorRotation();
+	Snapshot.ControlRotation = Controller ? Controller->GetControlRotation() : FRotator::ZeroRotator;
+	Snapshot.Velocity = Velocity;
+	Snapshot.MoveDirection = MoveDirection;
+	Snapshot.FallSpeed = FallSpeed;
+	Snapshot.MovementMode = MovementMode;
+	Snapshot.StateTimeRemaining = StateTimeRemaining;
+	Snapshot.MovementTimers = MovementTimers;
+	Snapshot.DroneVelocity = DroneVelocity;
+	return Snapshot;
+}
+
+void APracticeCharacter::ApplyMovementSnapshot(const FPracticeMovementSnapshot& Snapshot)
+{
+	// 상태를 그대로 덮어쓰므로 Enter / Exit는 호출하지 않는다.
+	WakeUp();
+	SetMovementBase(nullptr);
+	SetActorLocationAndRotation(Snapshot.Location, Snapshot.Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+	if (Controller)
 	{
-		Jump();
+		Controller->SetControlRotation(Snapshot.ControlRotation);
+		RefreshControlBasis();
+	}
+	Velocity = Snapshot.Velocity;
+	MoveDirection = Snapshot.MoveDirection;
+	FallSpeed = Snapshot.FallSpeed;
+	MovementMode = Snapshot.MovementMode;
+	StateTimeRemaining = Snapshot.StateTimeRemaining;
+	MovementTimers = Snapshot.MovementTimers;
+	DroneVelocity = Snapshot.DroneVelocity;
+	UpdateMovementModeFlags();
+
+	DeltaCameraRotator = FRotator::ZeroRotator;
+	SimulationAccumulator = 0.0f;
+	PrevSimulationTransform = GetActorTransform();
+}
+
+void APracticeCharacter::SetExternalStepping(bool bEnable)
+{
+	WakeUp();
+	if (bEnable)
+	{
+		// 배치 이동 상태는 WriteBack으로 Pawn에 복사되어 있으므로 등록만 해제한다.
+		if (UPracticeMovementSubsystem* MovementSubsystem = GetBatchedMovementSubsystem())
+		{
+			MovementSubsystem->UnregisterPawn(this);
+		}
+		SetActorTickEnabled(false);
+	}
+	else
+	{
+		// 배치 이동을 사용하면 현재 상태로 다시 등록하고 개별 Tick은 꺼진 채로 둔다.
+		SetActorTickEnabled(true);
+		RegisterBatchedMovement();
+	}
+}
+
+void APracticeCharacter::SetMoveInput(const FVector2D& NewInputDirection)
+{
+	// X축 : Forward, Y축 : Right
+	InputDirection = NewInputDirection.GetSafeNormal();
+	if (!InputDirection.IsZero())
+	{
+		WakeUp();
+	}
+
+	if (UPracticeMovementSubsystem* MovementSubsystem = GetBatchedMovementSubsystem())
+	{
+		MovementSubsystem->SetInputDirection(BatchedMovementIndex, InputDirection);
+	}
+}
+
+void APracticeCharacter::RequestJump()
+{
+	WakeUp();
+
+	// 배치 이동에서는 다음 이동 처리에서 점프를 판단한다.
+	if (UPracticeMovementSubsystem* MovementSubsystem = GetBatchedMovementSubsystem())
+	{
+		MovementSubsystem->RequestJump(BatchedMovementIndex);
+		return;
+	}
+
+	// 클라이언트 예측에서는 다음 이동 입력에 담아서 서버와 같은 순서로 처리한다.
+	if (GetLocalRole() == ROLE_AutonomousProxy)
+	{
+		PendingInputButtons |= EPracticeInputButtons::Jump;
+		return;
 	}
+
+	// 점프할 수 있는지는 전이 표에서 결정한다.
+	HandleMovementEvent(EPracticeMovementEvent::Jump);
 }
 
 
 void APracticeCharacter::PlaneMove(float DeltaTime)
 {
+	PRACTICE_MOVEMENT_SCOPE(PlaneMove);
+	PRACTICE_MOVEMENT_STAT_SCOPE(PlaneMove);
+
 	// 새로운 속력 계산
 	const float TargetVelocity = InputDirection.IsZero() ? 0.0f : MoveSpeed;
 	Velocity = CalculateVelocity(Velocity, TargetVelocity, DeltaTime);
@@ -166,29 +651,36 @@ void APracticeCharacter::PlaneMove(float DeltaTime)
 	// 새로운 속도를 계산
 	MoveDirection = GetMoveDirectionFromController();
 
-	// MoveDirection으로 회전
-	FaceDirection(MoveDirection, DeltaTime, TurnSmoothingDamp);
+	// MoveDirection으로 회전, 멀리 있으면 보간하지 않는다.
+	if (Significance == EPracticeSignificance::Far)
+	{
+		FaceDirection(MoveDirection);
+	}
+	else
+	{
+		FaceDirection(MoveDirection, DeltaTime, TurnSmoothingDamp);
+	}
 }
 
 float APracticeCharacter::CalculateVelocity(float CurrentVelocity, float TargetVelocity, const float DeltaTime) const
 {
-	if (FMath::IsNearlyEqual(TargetVelocity, CurrentVelocity))
-	{
-		return TargetVelocity;
-	}
-
-	const float Alpha = FMath::Clamp(DeltaTime * AccelDamp, 0.f, 1.f);
-	return FMath::Lerp(CurrentVelocity, TargetVelocity, Alpha);
+	return PracticeMovement::CalculateVelocity(CurrentVelocity, TargetVelocity, AccelDamp, DeltaTime);
 }
 
 FVector APracticeCharacter::GetMoveDirectionFromController() const
 {
 	// 카메라 기준 이동 벡터를 그대로 사용
 	// 그 후에 각각을 입력 벡터를 이용해서 현재 프레임에서의 월드 기준 이동 방향을 구한다.
-	const FRotator ControllerRotator = FRotator(0.f, Controller->GetControlRotation().Yaw, 0.f);
-	const FVector ControllerForwardVector = FRotationMatrix(ControllerRotator).GetUnitAxis(EAxis::X);
-	const FVector ControllerRightVector = FRotationMatrix(ControllerRotator).GetUnitAxis(EAxis::Y);
-	return (ControllerForwardVector * InputDirection.X + ControllerRightVector * InputDirection.Y).GetSafeNormal();
+	// 기준 벡터는 Controller 회전이 바뀔 때 한 번만 계산한다.
+	return ControlBasis.ToWorld(InputDirection);
+}
+
+void APracticeCharacter::RefreshControlBasis()
+{
+	if (Controller)
+	{
+		ControlBasis = FPracticeYawBasis(Controller->GetControlRotation().Yaw);
+	}
 }
 
 void APracticeCharacter::FaceDirection(FVector NewDirection, float DeltaTime, float Damp)
@@ -196,12 +688,10 @@ void APracticeCharacter::FaceDirection(FVector NewDirection, float DeltaTime, fl
 	if (NewDirection.IsZero())
 		return;
 	
-	FRotator TargetRotator = FRotationMatrix::MakeFromX(NewDirection).Rotator();
-	TargetRotator.Pitch = 0.0f;
-	TargetRotator.Roll = 0.0f;
-
-	FRotator SmoothRotator = FMath::RInterpTo(GetActorRotation(), TargetRotator, DeltaTime, Damp);
-	SetActorRotation(SmoothRotator);
+	// 지상 이동은 Yaw만 사용하므로 Matrix, Rotator 변환 없이 Yaw로 보간한다.
+	const float TargetYaw = PracticeMovement::GetFaceYaw(NewDirection);
+	const float SmoothYaw = PracticeMovement::InterpYawTo(GetActorRotation().Yaw, TargetYaw, DeltaTime, Damp);
+	SetActorRotation(PracticeMovement::MakeYawQuat(SmoothYaw));
 }
 
 void APracticeCharacter::FaceDirection(FVector NewDirection)
@@ -209,46 +699,81 @@ void APracticeCharacter::FaceDirection(FVector NewDirection)
 	if (NewDirection.IsZero())
 		return;
 	
-	FRotator TargetRotator = FRotationMatrix::MakeFromX(NewDirection).Rotator();
-	TargetRotator.Pitch = 0.0f;
-	TargetRotator.Roll = 0.0f;
+	SetActorRotation(PracticeMovement::MakeYawQuat(PracticeMovement::GetFaceYaw(NewDirection)));
+}
+
+void APracticeCharacter::Move(float DeltaTime, bool bAllowAsyncProbe)
+{
+	if (ShouldUseKinematicMove())
+	{
+		FallSpeed = 0.0f;
+		KinematicMove(MoveDirection * Velocity * DeltaTime, GetSeparationDelta(DeltaTime));
+		return;
+	}
+
+	UpdateFallSpeed(DeltaTime);
+	const FVector HorizontalDelta = MoveDirection * Velocity * DeltaTime + GetSeparationDelta(DeltaTime);
+	const FVector VerticalDelta = FVector::UpVector * FallSpeed * DeltaTime;
+
+	switch (SweepMove(HorizontalDelta, VerticalDelta, bAllowAsyncProbe))
+	{
+	case EPracticeSweepResult::Ground:
+		HandleMovementEvent(EPracticeMovementEvent::Land);
+		break;
+	case EPracticeSweepResult::Air:
+		HandleMovementEvent(EPracticeMovementEvent::LeaveGround);
+		break;
+	case EPracticeSweepResult::Wall:
+	default:
+		break;
+	}
+}
 
-	SetActorRotation(TargetRotator);
+FVector APracticeCharacter::GetSeparationDelta(float DeltaTime) const
+{
+	if (SeparationIndex == INDEX_NONE || GetLocalRole() != ROLE_Authority || !CanBePushed())
+	{
+		return FVector::ZeroVector;
+	}
+	const UPracticeSeparationSubsystem* SeparationSubsystem = GetWorld()->GetSubsystem<UPracticeSeparationSubsystem>();
+	return SeparationSubsystem ? SeparationSubsystem->GetSeparationVelocity(SeparationIndex) * DeltaTime : FVector::ZeroVector;
 }
 
-void APracticeCharacter::Move(float DeltaTime)
+EPracticeSweepResult APracticeCharacter::SweepMove(const FVector& HorizontalDelta, const FVector& VerticalDelta, bool bAllowAsyncProbe)
 {
+	PRACTICE_MOVEMENT_SCOPE(Move);
+
 	// Problem1 : 이동을 한 번에 처리하니까 바로 지면에 충돌해서 움직일 수 없는 상황이 발생
 	// 수평 / 수직 이동을 분리해서 처리한다.
-	FVector HorizontalDelta = MoveDirection * Velocity * DeltaTime;
-	FHitResult HorizontalHit;
-	AddActorWorldOffset(HorizontalDelta, true, &HorizontalHit);
-
-	// Problem2 : 경사로를 올라갈 수 없는 문제
-	// 1. 평지에서 경사로로 이동할 경우(평지에서 이동하고 남은 거리를 경사로로 이동)
-	// 2. 경사로에서 경사로로 이동할 경우(경사로 방향으로 이동 벡터를 조정)
-	float SlopeAngle = 0.f;
-	if (HorizontalHit.IsValidBlockingHit())
+	int32 NumSweeps = 0;
 	{
-		// 
-		SlopeAngle = FMath::RadiansToDegrees(FMath::Acos(FVector::DotProduct(HorizontalHit.ImpactNormal, FVector::UpVector)));
-		UE_LOG(LogTemp, Display, TEXT("Angle : %f"), SlopeAngle);
+		PRACTICE_MOVEMENT_STAT_SCOPE(HorizontalSweep);
+		SlideMove(HorizontalDelta, VerticalDelta.Z <= 0.f, NumSweeps);
 	}
-	
-	UpdateFallSpeed(DeltaTime);
-	FVector VerticalDelta = FVector::UpVector * FallSpeed * DeltaTime;
+
 	FHitResult VerticalHit;
-	AddActorWorldOffset(VerticalDelta, true, &VerticalHit);
+	{
+		PRACTICE_MOVEMENT_STAT_SCOPE(VerticalSweep);
+		AddActorWorldOffset(VerticalDelta, true, &VerticalHit);
+		++NumSweeps;
+	}
+
+	LastMoveSweepCount = NumSweeps;
+	INC_DWORD_STAT_BY(STAT_PracticeMoveSweeps, NumSweeps);
+	PRACTICE_MOVEMENT_COUNT_SWEEPS(NumSweeps);
 	
 	if (VerticalHit.IsValidBlockingHit())
 	{
-		if (VerticalHit.ImpactNormal.Z > 0.7f)
+		if (IsWalkable(VerticalHit.ImpactNormal))
 		{
 			// 지상과 충돌했을 경우
-			LandStart();
 			// UE_LOG(LogTemp, Display, TEXT("Land"));
+			// 추가 Trace 없이 수직 Sweep의 충돌로 Base를 기록한다.
+			SetMovementBase(VerticalHit.GetComponent());
+			return EPracticeSweepResult::Ground;
 		}
 		// else : 벽에 충돌
+		return EPracticeSweepResult::Wall;
 	}
 	else
 	{
@@ -265,94 +790,622 @@ void APracticeCharacter::Move(float DeltaTime)
 		// 3. 발의 Transform을 찾아서 정확한 착지 순간을 찾기 : 일반적인 상황에서 잘 작동하겠지만 착지 모션이 특이해서 발이 땅에 안 닿을 수 있다.
 		
 		// UE_LOG(LogTemp, Display, TEXT("Air"));
-		if (IsOnGround())
+		// 상승 중에는 지면 위에 있을 수 없으므로 지면 검사를 하지 않는다.
+		if (VerticalDelta.Z <= 0.f && IsOnGround(bAllowAsyncProbe))
 		{
-			LandStart();
 			// UE_LOG(LogTemp, Display, TEXT("Land By Line Trace"));
-		}
-		else
-		{
-			bIsFall = true;
+			// 지면 검사는 충돌한 Component를 알 수 없으므로 기록된 Base를 유지한다.
+			return EPracticeSweepResult::Ground;
 		}
 	}
+	SetMovementBase(nullptr);
+	return EPracticeSweepResult::Air;
 }
 
-void APracticeCharacter::UpdateFallSpeed(float DeltaTime)
+USceneComponent* APracticeCharacter::GetMovementBase() const
 {
-	if (FallSpeed >= 0)
-	{
-		FallSpeed += Gravity * DeltaTime;
-	}
-	else if (FallSpeed > TerminalSpeed)
+	if (MovementBaseIndex == INDEX_NONE)
 	{
-		FallSpeed += Gravity * DeltaTime * FallMultiplier;
-		FallSpeed = FallSpeed > TerminalSpeed ? FallSpeed : TerminalSpeed;
+		return nullptr;
 	}
+	const UPracticeMovementBaseSubsystem* MovementBaseSubsystem = GetWorld()->GetSubsystem<UPracticeMovementBaseSubsystem>();
+	return MovementBaseSubsystem ? MovementBaseSubsystem->GetBase(MovementBaseIndex) : nullptr;
 }
 
-bool APracticeCharacter::IsOnGround()
+void APracticeCharacter::SetMovementBase(UPrimitiveComponent* NewBase)
 {
-	FVector StartLocation = GetActorLocation() - FVector(0, 0, CapsuleComponent->GetScaledCapsuleHalfHeight());
-	FVector EndLocation = StartLocation - FVector::UpVector * GroundCheckDistance;
-
-	FHitResult GroundHit;
-	FCollisionQueryParams CollisionParams;
-	CollisionParams.AddIgnoredActor(this);
+	// Static, Stationary Component는 움직이지 않으므로 Base로 기록하지 않는다.
+	if (NewBase && NewBase->Mobility != EComponentMobility::Movable)
+	{
+		NewBase = nullptr;
+	}
+	if (!NewBase && MovementBaseIndex == INDEX_NONE)
+	{
+		return;
+	}
 
-	bool bHit = GetWorld()->LineTraceSingleByChannel(GroundHit, StartLocation, EndLocation, ECC_Visibility, CollisionParams);
-	return bHit;
+	if (UPracticeMovementBaseSubsystem* MovementBaseSubsystem = GetWorld()->GetSubsystem<UPracticeMovementBaseSubsystem>())
+	{
+		MovementBaseSubsystem->SetBase(this, NewBase);
+	}
 }
 
-// @To-Do: 속도 / 가속도 이동 방향 계산으로 통합하면 PlaneMove를 통합해서 처리할 수도 있을 것 같다.
-void APracticeCharacter::AirPlaneMove(float DeltaTime)
+void APracticeCharacter::ApplyBaseMovement(UPrimitiveComponent* Base, const FTransform& OldBaseTransform, const FTransform& NewBaseTransform, float DeltaYaw)
 {
-	// 속력 계산
-	// 공중 이동 시에는 초기 속도는 유지가 된다.
-	// 이동 방향에 대해서는 가속도 형식으로 더해준다.
-	// 현재는 속력과 이동 방향으로 관리하므로 최종 계산 후에 속력과 이동 방향을 계산해준다.
+	const FVector OldLocation = GetActorLocation();
+	const FVector NewLocation = NewBaseTransform.TransformPosition(OldBaseTransform.InverseTransformPosition(OldLocation));
+	FRotator NewRotation = GetActorRotation();
+	NewRotation.Yaw += DeltaYaw;
 
-	FVector CurrentSpeed = Velocity * MoveDirection;
-	
-	// 문제. 가속도 값만을 제한하니까 최종 속력을 넘어서 빨라질 수 있는 현상이 있다.
-	// 최종 속도를 값을 확인해서 최대 속도 이상으로 넘어가지 못하도록 수정
-	float AccelAmount = MoveSpeed * AirSpeedMultiplier * DeltaTime;
-	AccelAmount = FMath::Clamp(AccelAmount, 0.f, MoveSpeed * DeltaTime);
-	FVector Acceleration = GetMoveDirectionFromController() * AccelAmount;
-	
-	FVector NewSpeed = CurrentSpeed + Acceleration;
-	if (NewSpeed.Length() > MoveSpeed)
+	// Base는 이미 움직여서 Capsule과 겹쳐 있을 수 있으므로 Sweep에서 무시한다.
+	const bool bWasIgnoringBase = CapsuleComponent->GetMoveIgnoreComponents().Contains(Base);
+	CapsuleComponent->IgnoreComponentWhenMoving(Base, true);
+	FHitResult Hit;
+	SetActorLocationAndRotation(NewLocation, NewRotation, true, &Hit);
+	CapsuleComponent->IgnoreComponentWhenMoving(Base, bWasIgnoringBase);
+
+	// 벽, 천장에 막히면 Base와 같이 움직일 수 없다. Sleep 중이면 깨워서 다음 이동에서 지면과 Base를 다시 판단한다.
+	if (Hit.bBlockingHit)
 	{
-		NewSpeed = NewSpeed.GetSafeNormal() * MoveSpeed;
+		WakeUp();
 	}
-	MoveDirection = NewSpeed.GetSafeNormal();
-	Velocity = NewSpeed.Length();
+
+	// 고정 시간 간격의 보간 기준도 같이 옮겨서 Base 이동이 보간으로 늦게 보이지 않도록 한다.
+	PrevSimulationTransform.AddToTranslation(GetActorLocation() - OldLocation);
 }
 
-void APracticeCharacter::LandStart()
+void APracticeCharacter::KinematicMove(const FVector& HorizontalDelta, const FVector& SeparationDelta)
 {
-	if (bIsFall)
-	{
-		bIsLanding = true;
+	// 지면, 벽과의 충돌은 무시한다. 다시 가까워지면 Sweep 이동에서 바로잡는다.
+	AddActorWorldOffset(HorizontalDelta);
+	LastMoveSweepCount = 0;
 
-		GetWorldTimerManager().SetTimer(LandingLockTimerHandle, this, &APracticeCharacter::LandEnd, LandingLockTime, false);
+	// 밀어내기는 입력과 관계없이 군중이 계속 미는 힘이므로 Sweep 없이 적용하면 벽을 뚫고 나간다.
+	// 밀려나는 Pawn만 한 번 Sweep한다.
+	if (!SeparationDelta.IsZero())
+	{
+		AddActorWorldOffset(SeparationDelta, true);
+		LastMoveSweepCount = 1;
+	}
+
+	// 지면 검사를 하지 않으므로 Base의 수평 범위를 벗어나면 Base에서 내린다.
+	if (const USceneComponent* Base = GetMovementBase())
+	{
+		const FBox BaseBounds = Base->Bounds.GetBox().ExpandBy(FVector(CapsuleComponent->GetScaledCapsuleRadius(), CapsuleComponent->GetScaledCapsuleRadius(), 0.0f));
+		if (!BaseBounds.IsInsideOrOnXY(GetActorLocation()))
+		{
+			SetMovementBase(nullptr);
+		}
 	}
-	
-	// To-Do
-	// 1. bIsJumping, bIsFall을 하나로 통합할 수 있는지 확인할 것
-	// 2. 객체는 한 번에 하나의 상태를 가지고 있으므로 enum으로 현재 상태를 표현하는 것을 고려할 것.
-	// State Machine처럼 고려해도 될 것 같다.
-	// 지금 위에서 IsFall을 true로 바꾸는 순간 Land를 실행하는데 이는 State가 Fall에서 Land로 바뀌고 State Enter를 처리하는 것과 유사하다.
-	bIsJumping = false;
-	bIsFall = false;
 }
 
-void APracticeCharacter::LandEnd()
+bool APracticeCharacter::CanSleep() const
 {
-	bIsLanding = false;
+	// 남은 속도가 이보다 작으면 멈춘 것으로 본다.
+	constexpr float SleepSpeed = 1.0f;
+
+	// 착지 잠금, Jump Buffer, Coyote Time이 남아 있으면 시간이 흘러야 하므로 Walking에서 타이머가 없을 때만 잠든다.
+	return bCanSleep && CVarPracticeSleepEnable.GetValueOnGameThread()
+		&& MovementMode == EPracticeMovementMode::Walking
+		&& !MovementTimers.IsActive(EPracticeMovementTimer::JumpBuffer)
+		&& !MovementTimers.IsActive(EPracticeMovementTimer::Coyote)
+		&& InputDirection.IsZero()
+		&& FMath::Abs(Velocity) < SleepSpeed
+		&& DeltaCameraRotator.IsZero()
+		&& LookSmoothingRemainder.IsNearlyZero(0.01f)
+		&& GetSeparationDelta(1.0f).IsZero();
+}
+
+void APracticeCharacter::UpdateSleep(float DeltaTime)
+{
+	if (!CanSleep())
+	{
+		IdleTime = 0.0f;
+		return;
+	}
+
+	IdleTime += DeltaTime;
+	if (IdleTime >= SleepDelay)
+	{
+		Sleep();
+	}
+}
+
+void APracticeCharacter::Sleep()
+{
+	if (bIsSleeping)
+	{
+		return;
+	}
+	bIsSleeping = true;
+	Velocity = 0.0f;
+	FallSpeed = 0.0f;
+	SimulationAccumulator = 0.0f;
+	PrevSimulationTransform = GetActorTransform();
+	SetActorTickEnabled(false);
+	INC_DWORD_STAT(STAT_PracticeSleepingPawns);
+
+	// 기록된 Base 위에 있으면 UPracticeMovementBaseSubsystem이 깨우지 않고 같이 옮긴다.
+	// 옮기다가 막히거나 Base가 없어지면 UPracticeMovementBaseSubsystem이 깨운다.
+	if (MovementBaseIndex != INDEX_NONE)
+	{
+		return;
+	}
+
+	// 발밑 Component가 움직이거나 물리 상태가 없어지면(Destroy, 충돌 끔) 깨어난다.
+	// Static, Stationary는 움직이지 않으므로 Delegate를 등록하지 않는다.
+	const FVector StartLocation = GetActorLocation() - FVector(0, 0, CapsuleComponent->GetScaledCapsuleHalfHeight());
+	FHitResult GroundHit;
+	if (UPracticeGroundProbeSubsystem::TraceSync(GetWorld(), this, StartLocation, StartLocation - FVector::UpVector * GroundCheckDistance, GroundHit))
+	{
+		UPrimitiveComponent* GroundComponent = GroundHit.GetComponent();
+		if (GroundComponent && GroundComponent->Mobility == EComponentMobility::Movable)
+		{
+			SleepBase = GroundComponent;
+			SleepBaseMovedHandle = GroundComponent->TransformUpdated.AddUObject(this, &APracticeCharacter::OnSleepBaseMoved);
+			GroundComponent->OnComponentPhysicsStateChanged.AddDynamic(this, &APracticeCharacter::OnSleepBasePhysicsStateChanged);
+		}
+	}
+}
+
+void APracticeCharacter::WakeUp()
+{
+	if (!bIsSleeping)
+	{
+		return;
+	}
+	bIsSleeping = false;
+	IdleTime = 0.0f;
+
+	if (USceneComponent* Base = SleepBase.Get())
+	{
+		Base->TransformUpdated.Remove(SleepBaseMovedHandle);
+		CastChecked<UPrimitiveComponent>(Base)->OnComponentPhysicsStateChanged.RemoveDynamic(this, &APracticeCharacter::OnSleepBasePhysicsStateChanged);
+	}
+	SleepBase.Reset();
+	SleepBaseMovedHandle.Reset();
+
+	SetActorTickEnabled(true);
+	DEC_DWORD_STAT(STAT_PracticeSleepingPawns);
+	INC_DWORD_STAT(STAT_PracticePawnWakes);
+}
+
+void APracticeCharacter::OnSleepBaseMoved(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	WakeUp();
+}
+
+void APracticeCharacter::OnSleepBasePhysicsStateChanged(UPrimitiveComponent* ChangedComponent, EComponentPhysicsStateChange StateChange)
+{
+	if (StateChange == EComponentPhysicsStateChange::Destroyed)
+	{
+		WakeUp();
+	}
+}
+
+void APracticeCharacter::NotifyHit(UPrimitiveComponent* MyComp, AActor* Other, UPrimitiveComponent* OtherComp, bool bSelfMoved, FVector HitLocation, FVector HitNormal, FVector NormalImpulse, const FHitResult& Hit)
+{
+	Super::NotifyHit(MyComp, Other, OtherComp, bSelfMoved, HitLocation, HitNormal, NormalImpulse, Hit);
+
+	// 다른 물체가 움직여서 부딪힌 경우
+	if (!bSelfMoved)
+	{
+		WakeUp();
+	}
+}
+
+void APracticeCharacter::NotifyActorBeginOverlap(AActor* OtherActor)
+{
+	Super::NotifyActorBeginOverlap(OtherActor);
+
+	WakeUp();
+}
+
+float APracticeCharacter::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
+{
+	WakeUp();
+
+	return Super::TakeDamage(DamageAmount, DamageEvent, EventInstigator, DamageCauser);
+}
+
+void APracticeCharacter::SlideMove(const FVector& Delta, bool bCanStepUp, int32& NumSweeps)
+{
+	// Problem2 : 경사로를 올라갈 수 없는 문제
+	// 1. 평지에서 경사로로 이동할 경우(평지에서 이동하고 남은 거리를 경사로로 이동)
+	// 2. 경사로에서 경사로로 이동할 경우(경사로 방향으로 이동 벡터를 조정)
+	// 충돌할 때마다 남은 이동량을 충돌면을 따라 조정해서 다시 이동한다. 반복 횟수는 MaxSlideIterations로 제한한다.
+	// - 올라갈 수 있는 경사로 : 경사면 방향으로 이동량 유지
+	// - StepHeight 이하의 장애물 : 올라가서 이동
+	// - 벽 : 벽을 따라 미끄러짐
+	FVector RemainingDelta = Delta;
+	for (int32 Iteration = 0; Iteration < MaxSlideIterations && !RemainingDelta.IsNearlyZero(); ++Iteration)
+	{
+		FHitResult Hit;
+		AddActorWorldOffset(RemainingDelta, true, &Hit);
+		++NumSweeps;
+
+		if (!Hit.IsValidBlockingHit())
+		{
+			break;
+		}
+
+		const FVector LeftDelta = RemainingDelta * (1.f - Hit.Time);
+#if !UE_BUILD_SHIPPING
+		if (CVarPracticeMovementDebugSlide.GetValueOnGameThread() > 0)
+		{
+			RecordSlideHitDebug(Hit);
+		}
+#endif
+
+		if (IsWalkable(Hit.ImpactNormal))
+		{
+			// 경사면을 따라 남은 거리만큼 이동
+			RemainingDelta = FVector::VectorPlaneProject(LeftDelta, Hit.ImpactNormal).GetSafeNormal() * LeftDelta.Size();
+		}
+		else if (bCanStepUp && StepUp(LeftDelta, Hit, NumSweeps))
+		{
+			// 계단을 올라가면서 남은 이동을 모두 처리했다.
+			break;
+		}
+		else
+		{
+			// 벽의 수평 방향으로만 미끄러진다. 벽을 타고 올라가지 않도록 수직 성분은 사용하지 않는다.
+			RemainingDelta = FVector::VectorPlaneProject(LeftDelta, Hit.Normal.GetSafeNormal2D());
+		}
+	}
+}
+
+bool APracticeCharacter::StepUp(const FVector& Delta, const FHitResult& Hit, int32& NumSweeps)
+{
+	if (StepHeight <= 0.f)
+	{
+		return false;
+	}
+
+	// 충돌 지점이 발 위치에서 StepHeight 이하일 때만 올라간다.
+	const FVector StartLocation = GetActorLocation();
+	const float FootZ = StartLocation.Z - CapsuleComponent->GetScaledCapsuleHalfHeight();
+	if (Hit.ImpactPoint.Z - FootZ > StepHeight)
+	{
+		return false;
+	}
+
+	// 1. 위로
+	FHitResult UpHit;
+	AddActorWorldOffset(FVector::UpVector * StepHeight, true, &UpHit);
+	++NumSweeps;
+	const float RaisedHeight = GetActorLocation().Z - StartLocation.Z;
+
+	// 2. 앞으로
+	FHitResult ForwardHit;
+	AddActorWorldOffset(Delta, true, &ForwardHit);
+	++NumSweeps;
+	if (ForwardHit.IsValidBlockingHit() && !IsWalkable(ForwardHit.ImpactNormal))
+	{
+		SetActorLocation(StartLocation);
+		return false;
+	}
+
+	// 3. 아래로, 올라간 높이만큼 내려서 계단 위의 지면을 찾는다.
+	FHitResult DownHit;
+	AddActorWorldOffset(FVector::DownVector * RaisedHeight, true, &DownHit);
+	++NumSweeps;
+	if (!DownHit.IsValidBlockingHit() || !IsWalkable(DownHit.ImpactNormal))
+	{
+		SetActorLocation(StartLocation);
+		return false;
+	}
+
+	return true;
+}
+
+#if !UE_BUILD_SHIPPING
+void APracticeCharacter::RecordSlideHitDebug(const FHitResult& Hit)
+{
+	const float SlopeAngle = FMath::RadiansToDegrees(FMath::Acos(FVector::DotProduct(Hit.ImpactNormal, FVector::UpVector)));
+	++DebugSlideHitCount;
+	DebugSlopeAngleSum += SlopeAngle;
+
+	const int32 DebugLevel = CVarPracticeMovementDebugSlide.GetValueOnGameThread();
+	if (DebugLevel >= 3)
+	{
+		UE_VLOG_ARROW(this, LogPracticeMovement, Verbose, Hit.ImpactPoint, Hit.ImpactPoint + Hit.ImpactNormal * 50.0f,
+			IsWalkable(Hit.ImpactNormal) ? FColor::Green : FColor::Red, TEXT("%.1f"), SlopeAngle);
+	}
+
+	// 일정 간격마다 초당 충돌 횟수와 평균 경사각만 출력한다.
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	if (DebugSummaryStartTime <= 0.0)
+	{
+		DebugSummaryStartTime = CurrentTime;
+		return;
+	}
+
+	const double Elapsed = CurrentTime - DebugSummaryStartTime;
+	if (Elapsed < CVarPracticeMovementDebugSlideInterval.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	const float HitsPerSecond = DebugSlideHitCount / Elapsed;
+	const float AverageAngle = DebugSlopeAngleSum / DebugSlideHitCount;
+	UE_LOG(LogPracticeMovement, Log, TEXT("%s slide hits : %.1f/s, average slope angle : %.1f"), *GetName(), HitsPerSecond, AverageAngle);
+	UE_VLOG(this, LogPracticeMovement, Log, TEXT("slide hits : %.1f/s, average slope angle : %.1f"), HitsPerSecond, AverageAngle);
+	if (DebugLevel >= 2 && GEngine)
+	{
+		GEngine->AddOnScreenDebugMessage(static_cast<uint64>(GetUniqueID()), Elapsed, FColor::Yellow,
+			FString::Printf(TEXT("%s slide hits : %.1f/s, slope : %.1f"), *GetName(), HitsPerSecond, AverageAngle));
+	}
+
+	DebugSlideHitCount = 0;
+	DebugSlopeAngleSum = 0.0f;
+	DebugSummaryStartTime = CurrentTime;
+}
+#endif
+
+bool APracticeCharacter::IsWalkable(const FVector& ImpactNormal) const
+{
+	return ImpactNormal.Z >= FMath::Cos(FMath::DegreesToRadians(AllowedSlopeAngle));
+}
+
+void APracticeCharacter::UpdateFallSpeed(float DeltaTime)
+{
+	FallSpeed = PracticeMovement::UpdateFallSpeed(FallSpeed, GetMovementParams(), DeltaTime);
+}
+
+FPracticeMovementParams APracticeCharacter::GetMovementParams() const
+{
+	FPracticeMovementParams Params;
+	Params.MoveSpeed = MoveSpeed;
+	Params.AccelDamp = AccelDamp;
+	Params.TurnSmoothingDamp = TurnSmoothingDamp;
+	Params.JumpVelocity = JumpVelocity;
+	Params.MaxJumpHorizontalVelocity = MaxJumpHorizontalVelocity;
+	Params.FallMultiplier = FallMultiplier;
+	Params.TerminalSpeed = TerminalSpeed;
+	Params.LandingLockTime = LandingLockTime;
+	Params.JumpBufferTime = JumpBufferTime;
+	Params.CoyoteTime = CoyoteTime;
+	Params.Gravity = Gravity;
+	Params.AirSpeedMultiplier = AirSpeedMultiplier;
+	return Params;
+}
+
+bool APracticeCharacter::IsOnGround(bool bAllowAsync)
+{
+	PRACTICE_MOVEMENT_SCOPE(IsOnGround);
+	PRACTICE_MOVEMENT_STAT_SCOPE(IsOnGround);
+
+	FVector StartLocation = GetActorLocation() - FVector(0, 0, CapsuleComponent->GetScaledCapsuleHalfHeight());
+	FVector EndLocation = StartLocation - FVector::UpVector * GroundCheckDistance;
+
+	// 정적인 평지는 미리 만든 높이 캐시로 답한다.
+	if (const UPracticeGroundCacheSubsystem* GroundCacheSubsystem = GetWorld()->GetSubsystem<UPracticeGroundCacheSubsystem>())
+	{
+		bool bOnGround;
+		if (GroundCacheSubsystem->QueryGround(StartLocation, GroundCheckDistance, FMath::Cos(FMath::DegreesToRadians(AllowedSlopeAngle)), bOnGround))
+		{
+			return bOnGround;
+		}
+	}
+
+	// 매 프레임 호출되는 경우에는 비동기 Probe를 사용한다. 결과는 한 프레임 늦다.
+	if (bAllowAsync)
+	{
+		if (UPracticeGroundProbeSubsystem* GroundProbeSubsystem = GetWorld()->GetSubsystem<UPracticeGroundProbeSubsystem>())
+		{
+			return GroundProbeSubsystem->Probe(this, StartLocation, EndLocation);
+		}
+	}
+
+	return UPracticeGroundProbeSubsystem::TraceSync(GetWorld(), this, StartLocation, EndLocation);
+}
+
+// @To-Do: 속도 / 가속도 이동 방향 계산으로 통합하면 PlaneMove를 통합해서 처리할 수도 있을 것 같다.
+void APracticeCharacter::AirPlaneMove(float DeltaTime)
+{
+	PRACTICE_MOVEMENT_SCOPE(AirPlaneMove);
+	PRACTICE_MOVEMENT_STAT_SCOPE(AirPlaneMove);
+
+	// 속력 계산
+	// 공중 이동 시에는 초기 속도는 유지가 된다.
+	// 이동 방향에 대해서는 가속도 형식으로 더해준다.
+	// 현재는 속력과 이동 방향으로 관리하므로 최종 계산 후에 속력과 이동 방향을 계산해준다.
+
+	// 문제. 가속도 값만을 제한하니까 최종 속력을 넘어서 빨라질 수 있는 현상이 있다.
+	// 최종 속도를 값을 확인해서 최대 속도 이상으로 넘어가지 못하도록 수정
+	PracticeMovement::AirAccelerate(Velocity, MoveDirection, GetMoveDirectionFromController(), GetMovementParams(), DeltaTime);
+}
+
+void APracticeCharacter::HandleMovementEvent(EPracticeMovementEvent Event)
+{
+	EPracticeMovementMode NextMode = PracticeMovement::GetNextMode(MovementMode, Event);
+	if (Event == EPracticeMovementEvent::Jump)
+	{
+		// Coyote Time, Jump Buffer를 함께 판단한다.
+		NextMode = PracticeMovement::ResolveJump(MovementMode, MovementTimers, GetMovementParams());
+		if (NextMode == MovementMode && MovementTimers.IsActive(EPracticeMovementTimer::JumpBuffer))
+		{
+			INC_DWORD_STAT(STAT_PracticeMovementTimerStarts);
+		}
+	}
+
+	if (NextMode != MovementMode)
+	{
+		SetMovementMode(NextMode);
+	}
+}
+
+void APracticeCharacter::SetMovementMode(EPracticeMovementMode NewMode)
+{
+	const EPracticeMovementMode PrevMode = MovementMode;
+	OnExitMovementMode(NewMode);
+	MovementMode = NewMode;
+	UpdateMovementModeFlags();
+	OnEnterMovementMode(PrevMode);
+}
+
+void APracticeCharacter::OnEnterMovementMode(EPracticeMovementMode PrevMode)
+{
+	switch (MovementMode)
+	{
+	case EPracticeMovementMode::Walking:
+		// 공중, 착지 잠금 중에 누른 점프를 이어서 처리한다.
+		if (MovementTimers.IsActive(EPracticeMovementTimer::JumpBuffer))
+		{
+			INC_DWORD_STAT(STAT_PracticeBufferedJumps);
+			HandleMovementEvent(EPracticeMovementEvent::Jump);
+		}
+		break;
+	case EPracticeMovementMode::Jumping:
+		if (PrevMode == EPracticeMovementMode::Falling)
+		{
+			INC_DWORD_STAT(STAT_PracticeCoyoteJumps);
+		}
+		MovementTimers.Clear(EPracticeMovementTimer::JumpBuffer);
+		MovementTimers.Clear(EPracticeMovementTimer::Coyote);
+		Jump();
+		break;
+	case EPracticeMovementMode::Falling:
+		if (PracticeMovement::IsGroundMode(PrevMode) && CoyoteTime > 0.0f)
+		{
+			MovementTimers.Start(EPracticeMovementTimer::Coyote, CoyoteTime);
+			INC_DWORD_STAT(STAT_PracticeMovementTimerStarts);
+		}
+		break;
+	case EPracticeMovementMode::Drone:
+		MovementTimers.Reset();
+		EnterDrone();
+		break;
+	case EPracticeMovementMode::Landing:
+		// 스카이 콩콩 문제 : 착지 후 일정 시간 점프 잠금
+		// Timer 대신 상태의 남은 시간으로 처리한다.
+		StateTimeRemaining = LandingLockTime;
+		INC_DWORD_STAT(STAT_PracticeLandings);
+		// 잠금 시간이 0 이하면 줄일 시간이 없으므로 바로 끝낸다.
+		if (StateTimeRemaining > 0.0f)
+		{
+			INC_DWORD_STAT(STAT_PracticeMovementTimerStarts);
+		}
+		else
+		{
+			HandleMovementEvent(EPracticeMovementEvent::Timeout);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void APracticeCharacter::OnExitMovementMode(EPracticeMovementMode NextMode)
+{
+	StateTimeRemaining = 0.0f;
+
+	if (MovementMode == EPracticeMovementMode::Drone)
+	{
+		ExitDrone();
+	}
+}
+
+void APracticeCharacter::TickMovementMode(float DeltaTime)
+{
+	if (PracticeMovement::TickStateTime(StateTimeRemaining, DeltaTime))
+	{
+		HandleMovementEvent(EPracticeMovementEvent::Timeout);
+	}
+
+	// 상태 시간이 끝나서 Walking에 들어간 경우에도 이번 프레임의 Jump Buffer를 사용할 수 있도록 나중에 줄인다.
+	PracticeMovement::TickMovementTimers(MovementTimers, MovementMode, DeltaTime);
+}
+
+void APracticeCharacter::UpdateMovementModeFlags()
+{
+	// 점프 중에는 상승 / 하강 모두 공중이다.
+	bIsFall = MovementMode == EPracticeMovementMode::Jumping || MovementMode == EPracticeMovementMode::Falling;
+	bIsJumping = MovementMode == EPracticeMovementMode::Jumping;
+	bIsLanding = MovementMode == EPracticeMovementMode::Landing;
+	IsDrone = MovementMode == EPracticeMovementMode::Drone;
+}
+
+void APracticeCharacter::EnterDrone()
+{
+	// 현재 이동 속도를 그대로 이어받는다. 상태 전환에서는 값만 바꾸고 할당하지 않는다.
+	DroneVelocity = MoveDirection * Velocity + FVector::UpVector * FallSpeed;
+	FallSpeed = 0.0f;
+	SetMovementBase(nullptr);
+}
+
+void APracticeCharacter::ExitDrone()
+{
+	// 드론 속도를 지상 이동의 속력, 이동 방향, 낙하 속도로 나눈다.
+	Velocity = FMath::Min(DroneVelocity.Size2D(), MoveSpeed);
+	MoveDirection = DroneVelocity.GetSafeNormal2D();
+	FallSpeed = DroneVelocity.Z;
+	DroneVelocity = FVector::ZeroVector;
+	DroneThrustInput = 0.0f;
+
+	// 지상 이동은 Yaw만 사용한다.
+	SetActorRotation(FRotator(0.0f, GetActorRotation().Yaw, 0.0f));
+	if (Controller)
+	{
+		FRotator ControlRotation = Controller->GetControlRotation();
+		ControlRotation.Roll = 0.0f;
+		Controller->SetControlRotation(ControlRotation);
+	}
+}
+
+void APracticeCharacter::DroneMove(float DeltaTime)
+{
+	if (!Controller)
+	{
+		return;
+	}
+
+	// 1. 회전 : Controller의 회전을 그대로 따른다.
+	const FRotator ControlRotation = Controller->GetControlRotation();
+	SetActorRotation(ControlRotation);
+
+	// 2. 속도 : 추력 - 공기 저항
+	const FRotationMatrix RotationMatrix(ControlRotation);
+	const FVector ThrustDirection =
+		RotationMatrix.GetUnitAxis(EAxis::X) * InputDirection.X +
+		RotationMatrix.GetUnitAxis(EAxis::Y) * InputDirection.Y +
+		RotationMatrix.GetUnitAxis(EAxis::Z) * DroneThrustInput;
+	DroneVelocity += ThrustDirection.GetClampedToMaxSize(1.0f) * DroneThrust * DeltaTime;
+	// 선형 저항을 암시적으로 적용해서 DeltaTime이 커져도 방향이 뒤집히지 않는다.
+	DroneVelocity /= 1.0f + DroneDrag * DeltaTime;
+	DroneVelocity = DroneVelocity.GetClampedToMaxSize(DroneMaxSpeed);
+
+	// 3. 이동 : 충돌면을 따라 미끄러진다. 지면 검사는 하지 않는다.
+	FVector RemainingDelta = DroneVelocity * DeltaTime;
+	int32 NumSweeps = 0;
+	for (int32 Iteration = 0; Iteration < MaxSlideIterations && !RemainingDelta.IsNearlyZero(); ++Iteration)
+	{
+		FHitResult Hit;
+		AddActorWorldOffset(RemainingDelta, true, &Hit);
+		++NumSweeps;
+
+		if (!Hit.IsValidBlockingHit())
+		{
+			break;
+		}
+
+		RemainingDelta = FVector::VectorPlaneProject(RemainingDelta * (1.f - Hit.Time), Hit.Normal);
+		DroneVelocity = FVector::VectorPlaneProject(DroneVelocity, Hit.Normal);
+	}
+
+	LastMoveSweepCount = NumSweeps;
+	INC_DWORD_STAT_BY(STAT_PracticeMoveSweeps, NumSweeps);
+	PRACTICE_MOVEMENT_COUNT_SWEEPS(NumSweeps);
 }
 
 void APracticeCharacter::AddControllerRotation(float Pitch, float Yaw, float Roll)
 {
+	if (Pitch != 0.0f || Yaw != 0.0f || Roll != 0.0f)
+	{
+		WakeUp();
+	}
+
 	DeltaCameraRotator.Pitch += Pitch;
 	DeltaCameraRotator.Yaw += Yaw;
 	DeltaCameraRotator.Roll += Roll;
@@ -360,49 +1413,612 @@ void APracticeCharacter::AddControllerRotation(float Pitch, float Yaw, float Rol
 
 void APracticeCharacter::UpdateControllerRotation(float DeltaTime)
 {
-	FRotator CurrentDeltaRotator = DeltaCameraRotator * DeltaTime;
-	CurrentDeltaRotator.Yaw *= MouseXSensitive;
+	PRACTICE_MOVEMENT_STAT_SCOPE(UpdateControllerRotation);
+
+	// 마우스 이동량은 감도만 곱하고, Roll은 누르고 있는 동안 들어오는 초당 각도이므로 DeltaTime을 곱한다.
+	FRotator CurrentDeltaRotator(DeltaCameraRotator.Pitch * MouseYSensitive, DeltaCameraRotator.Yaw * MouseXSensitive, DeltaCameraRotator.Roll * DeltaTime);
+
+	// 마우스 가속 : 초당 이동량에 따라 감도 배율을 정한다.
+	const FRichCurve* AccelerationCurve = LookAccelerationCurve.GetRichCurveConst();
+	if (AccelerationCurve && AccelerationCurve->GetNumKeys() > 0 && DeltaTime > 0.0f)
+	{
+		const float InputSpeed = FVector2D(DeltaCameraRotator.Yaw, DeltaCameraRotator.Pitch).Size() / DeltaTime;
+		const float Scale = AccelerationCurve->Eval(InputSpeed, 1.0f);
+		CurrentDeltaRotator.Pitch *= Scale;
+		CurrentDeltaRotator.Yaw *= Scale;
+	}
+
+	// 부드럽게 : 남은 회전 중 프레임 시간에 맞는 비율만 적용한다. 비율은 프레임 수와 관계없이 같은 곡선을 따른다.
+	// 최대 회전 각도를 넘는 부분은 남은 회전에 두고 다음 프레임에 적용하므로 전체 회전 각도는 입력과 같다.
+	if (LookSmoothingTime > 0.0f)
+	{
+		LookSmoothingRemainder.Pitch += CurrentDeltaRotator.Pitch;
+		LookSmoothingRemainder.Yaw += CurrentDeltaRotator.Yaw;
+		const float Alpha = 1.0f - FMath::Exp(-DeltaTime / LookSmoothingTime);
+		CurrentDeltaRotator.Pitch = FMath::Clamp(LookSmoothingRemainder.Pitch * Alpha, -MaxControllerRotation.Pitch, MaxControllerRotation.Pitch);
+		CurrentDeltaRotator.Yaw = FMath::Clamp(LookSmoothingRemainder.Yaw * Alpha, -MaxControllerRotation.Yaw, MaxControllerRotation.Yaw);
+		LookSmoothingRemainder.Pitch -= CurrentDeltaRotator.Pitch;
+		LookSmoothingRemainder.Yaw -= CurrentDeltaRotator.Yaw;
+	}
+
 	CurrentDeltaRotator.Yaw = FMath::Clamp(CurrentDeltaRotator.Yaw, -MaxControllerRotation.Yaw, MaxControllerRotation.Yaw);
-	CurrentDeltaRotator.Pitch *= MouseYSensitive;
-	CurrentDeltaRotator.Pitch = FMath::Clamp(CurrentDeltaRotator.Pitch, -MaxControllerRotation.Pitch, MaxControllerRotation.Pitch);;
+	CurrentDeltaRotator.Pitch = FMath::Clamp(CurrentDeltaRotator.Pitch, -MaxControllerRotation.Pitch, MaxControllerRotation.Pitch);
 	CurrentDeltaRotator.Roll = FMath::Clamp(CurrentDeltaRotator.Roll, -MaxControllerRotation.Roll, MaxControllerRotation.Roll);
 	const FRotator ControllerRotator = Controller->GetControlRotation();
-	// 반대로 회전할 수 있나? Normalize가 이를 방지할 수 있다고 알고 있는데 추후에 찾아볼 것.
 	FRotator NewRotator = CurrentDeltaRotator + ControllerRotator;
 	NewRotator.Normalize();
+	// Pitch가 ±90을 넘으면 Camera가 뒤집히므로 범위를 제한한다. 드론은 모든 방향으로 회전할 수 있다.
+	if (MovementMode != EPracticeMovementMode::Drone)
+	{
+		NewRotator.Pitch = FMath::Clamp(NewRotator.Pitch, MinViewPitch, MaxViewPitch);
+	}
 	Controller->SetControlRotation(NewRotator);
+	RefreshControlBasis();
 	
 	DeltaCameraRotator = FRotator::ZeroRotator;
 }
 
+void APracticeCharacter::SetSignificance(EPracticeSignificance NewSignificance, float TickInterval)
+{
+	Significance = NewSignificance;
+
+	// Animation 갱신 간격도 이동에 맞춘다. Component Tick은 사이 시간을 누적해서 전달한다.
+	MeshComponent->SetComponentTickInterval(TickInterval);
+
+	if (UPracticeMovementSubsystem* MovementSubsystem = GetBatchedMovementSubsystem())
+	{
+		MovementSubsystem->SetSignificance(BatchedMovementIndex, NewSignificance, TickInterval);
+	}
+	else
+	{
+		SetActorTickInterval(TickInterval);
+	}
+}
+
 void APracticeCharacter::UpdateCamera()
+{
+	if (!bCameraRigActive)
+	{
+		// 보여줄 Camera가 없으므로 지연도 측정하지 않는다.
+		LookInputCycles = 0;
+		return;
+	}
+
+	// Camera Manager가 프레임 마지막에 갱신한다.
+	if (bLateCameraUpdate)
+	{
+		return;
+	}
+
+	PRACTICE_MOVEMENT_STAT_SCOPE(UpdateCamera);
+	PRACTICE_MOVEMENT_SCOPE(UpdateCamera);
+
+	ApplyCameraRotation();
+}
+
+void APracticeCharacter::UpdateCameraLate(float DeltaTime)
+{
+	if (!bCameraRigActive || !Controller)
+	{
+		LookInputCycles = 0;
+		return;
+	}
+
+	PRACTICE_MOVEMENT_STAT_SCOPE(UpdateCamera);
+	PRACTICE_MOVEMENT_SCOPE(UpdateCamera);
+
+	// 회전과 Arm 위치를 한 번에 적용해서 Spring Arm -> Camera Transform 갱신도 한 번만 한다.
+	ApplyCameraRotation();
+	SpringArmComponent->UpdateArm(DeltaTime);
+}
+
+void APracticeCharacter::ApplyCameraRotation()
 {
 	SpringArmComponent->SetWorldRotation(Controller->GetControlRotation());
+
+	if (LookInputCycles != 0)
+	{
+		PRACTICE_MOVEMENT_RECORD_LOOK_LATENCY(FPlatformTime::Cycles64() - LookInputCycles);
+		LookInputCycles = 0;
+	}
+}
+
+void APracticeCharacter::SetLateCameraUpdate(bool bEnable)
+{
+	if (bLateCameraUpdate == bEnable)
+	{
+		return;
+	}
+	bLateCameraUpdate = bEnable;
+
+	// 늦은 갱신에서는 Spring Arm의 Component Tick 대신 UpdateCameraLate에서 Arm을 갱신한다.
+	SpringArmComponent->SetComponentTickEnabled(bCameraRigActive && !bLateCameraUpdate);
+}
+
+void APracticeCharacter::NotifyControllerChanged()
+{
+	Super::NotifyControllerChanged();
+
+	UpdateCameraRig();
+}
+
+void APracticeCharacter::OnPlayerStateChanged(APlayerState* NewPlayerState, APlayerState* OldPlayerState)
+{
+	Super::OnPlayerStateChanged(NewPlayerState, OldPlayerState);
+
+	if (UPracticeSeparationSubsystem* SeparationSubsystem = GetWorld()->GetSubsystem<UPracticeSeparationSubsystem>())
+	{
+		SeparationSubsystem->UpdatePawnCollision(this);
+	}
+}
+
+void APracticeCharacter::UpdateCameraRig()
+{
+	if (!(HasActorBegunPlay() || IsActorBeginningPlay()) || bIsPooled)
+	{
+		return;
+	}
+
+	// Controller가 바뀌면 새 Camera Manager가 다시 늦은 갱신을 켠다.
+	SetLateCameraUpdate(false);
+
+	// 서버에 있는 원격 플레이어의 Pawn, AI, Simulated Proxy는 보는 사람이 없다.
+	SetCameraRigActive(bAlwaysUseCameraRig || (IsLocallyControlled() && IsPlayerControlled()));
+}
+
+void APracticeCharacter::SetCameraRigActive(bool bActive)
+{
+	if (bCameraRigActive == bActive)
+	{
+		return;
+	}
+	bCameraRigActive = bActive;
+
+	if (bActive)
+	{
+		SpringArmComponent->AttachToComponent(CapsuleComponent, FAttachmentTransformRules::KeepRelativeTransform);
+		SpringArmComponent->SetRelativeLocation(SpringArmRelativeLocation);
+		if (Controller)
+		{
+			SpringArmComponent->SetWorldRotation(Controller->GetControlRotation());
+		}
+		INC_DWORD_STAT(STAT_PracticeActiveCameraRigs);
+	}
+	else
+	{
+		// 떼어 놓으면 Capsule이 움직여도 Spring Arm, Camera의 Transform을 갱신하지 않는다.
+		SpringArmComponent->DetachFromComponent(FDetachmentTransformRules::KeepRelativeTransform);
+		DEC_DWORD_STAT(STAT_PracticeActiveCameraRigs);
+	}
+
+	SpringArmComponent->SetComponentTickEnabled(bActive && !bLateCameraUpdate);
+	CameraComponent->SetActive(bActive);
+}
+
+void APracticeCharacter::SimulateMovement(float DeltaTime, bool bAllowAsyncProbe)
+{
+	switch (MovementMode)
+	{
+	// 지상 이동
+	case EPracticeMovementMode::Walking:
+	case EPracticeMovementMode::Landing:
+		FallSpeed = 0;
+		PlaneMove(DeltaTime);
+		Move(DeltaTime, bAllowAsyncProbe);
+		break;
+	// 공중 이동
+	case EPracticeMovementMode::Jumping:
+	case EPracticeMovementMode::Falling:
+		AirPlaneMove(DeltaTime);
+		Move(DeltaTime, bAllowAsyncProbe);
+		break;
+	// 드론 이동, 중력과 지면 검사 없이 따로 이동한다.
+	case EPracticeMovementMode::Drone:
+		DroneMove(DeltaTime);
+		break;
+	default:
+		break;
+	}
+
+	// 이전의 FTimerManager Timer와 같이 착지한 프레임의 시간부터 센다.
+	// 착지 잠금은 다음 프레임의 입력 전에 끝난다.
+	TickMovementMode(DeltaTime);
+}
+
+void APracticeCharacter::TickFixedStep(float DeltaTime)
+{
+	// 고정 시간 간격으로 이동을 처리하고, 남은 시간만큼 Mesh와 Camera를 보간한다.
+	// Capsule(Root)은 항상 마지막 시뮬레이션 위치에 있고, 보이는 위치만 이전 위치와 보간된다.
+	const float StepTime = 1.0f / FMath::Max(FixedStepRate, 1.0f);
+	SimulationAccumulator += DeltaTime;
+
+	int32 NumSubSteps = 0;
+	while (SimulationAccumulator >= StepTime && NumSubSteps < MaxSubSteps)
+	{
+		PrevSimulationTransform = GetActorTransform();
+		// 비동기 Probe는 프레임마다 한 번만 결과가 나오므로 두 번째 Sub-step부터 같은 결과를 다시 받는다.
+		// Sub-step마다 이동한 위치를 검사하도록 동기 Trace(혹은 높이 캐시)를 사용한다.
+		SimulateMovement(StepTime, false);
+		SimulationAccumulator -= StepTime;
+		++NumSubSteps;
+	}
+
+	// 느린 프레임에서는 최대 Sub-step까지만 처리하고 남은 시간은 버린다.
+	if (SimulationAccumulator >= StepTime)
+	{
+		SimulationAccumulator = FMath::Fmod(SimulationAccumulator, StepTime);
+	}
+
+	INC_DWORD_STAT_BY(STAT_PracticeFixedSubSteps, NumSubSteps);
+
+	ApplyRenderInterpolation(SimulationAccumulator / StepTime);
+}
+
+void APracticeCharacter::ApplyRenderInterpolation(float Alpha)
+{
+	const FTransform CurrentTransform = GetActorTransform();
+
+	FTransform RenderTransform;
+	RenderTransform.Blend(PrevSimulationTransform, CurrentTransform, Alpha);
+
+	MeshComponent->SetWorldTransform(MeshRelativeTransform * RenderTransform);
+	if (bCameraRigActive)
+	{
+		SpringArmComponent->SetWorldLocation(RenderTransform.TransformPosition(SpringArmRelativeLocation));
+	}
+}
+
+void APracticeCharacter::TickMovement(float DeltaTime)
+{
+	// 카메라 방향, 이동, 카메라의 위치 결정 순서로 작성, 추후에 이상이 있을 경우 순서 조정
+
+	UpdateControllerRotation(DeltaTime);
+
+	if (bUseFixedTimestep)
+	{
+		TickFixedStep(DeltaTime);
+	}
+	else
+	{
+		SimulateMovement(DeltaTime);
+	}
+
+	UpdateCamera();
 }
 
 // Called every frame
 void APracticeCharacter::Tick(float DeltaTime)
 {
+#if STATS
+	const double TickStartTime = FPlatformTime::Seconds();
+#endif
+	PRACTICE_MOVEMENT_SCOPE(Tick);
+
 	Super::Tick(DeltaTime);
 
-	// 카메라 방향, 이동, 카메라의 위치 결정 순서로 작성, 추후에 이상이 있을 경우 순서 조정
+	switch (GetLocalRole())
+	{
+	case ROLE_AutonomousProxy:
+		TickAutonomousProxy(DeltaTime);
+		break;
+	case ROLE_SimulatedProxy:
+		TickSimulatedProxy(DeltaTime);
+		break;
+	default:
+		INC_DWORD_STAT(STAT_PracticeAwakePawns);
+		TickMovement(DeltaTime);
+		PendingInputButtons = 0;
+		UpdateSleep(DeltaTime);
+		break;
+	}
+
+#if STATS
+	// 배치 이동과 비교하기 위해서 개별 Tick 비용을 기록
+	if (UPracticeMovementSubsystem* MovementSubsystem = GetWorld()->GetSubsystem<UPracticeMovementSubsystem>())
+	{
+		MovementSubsystem->AddActorTickTime(FPlatformTime::Seconds() - TickStartTime);
+	}
+#endif
+}
+
+void APracticeCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// 조종하는 클라이언트는 예측과 보정을 사용하므로 다른 클라이언트에만 보낸다.
+	DOREPLIFETIME_CONDITION(APracticeCharacter, NetMovement, COND_SimulatedOnly);
+}
+
+void APracticeCharacter::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	// 배치 이동, 개별 Tick, ServerMove 어느 경로로 움직여도 복제 직전의 상태를 보낸다.
+	NetMovement.Location = GetActorLocation();
+	NetMovement.Rotation = GetActorRotation();
+	NetMovement.Velocity = Velocity;
+	NetMovement.MovementMode = MovementMode;
+
+	Super::PreReplication(ChangedPropertyTracker);
+}
+
+void APracticeCharacter::PossessedBy(AController* NewController)
+{
+	Super::PossessedBy(NewController);
+	RefreshControlBasis();
 
+	// 원격 플레이어의 Pawn은 서버에서 ServerMove로만 움직인다.
+	if (NewController && NewController->IsPlayerController() && !NewController->IsLocalController())
+	{
+		SetExternalStepping(true);
+	}
+}
+
+void APracticeCharacter::SimulateNetMove(const FPracticeNetMove& Move)
+{
+	// 입력 콜백과 같은 순서로 버튼 입력은 Controller 회전 갱신 전에 처리한다.
+	if (Move.Flags & FPracticeNetMove::Jump)
+	{
+		HandleMovementEvent(EPracticeMovementEvent::Jump);
+	}
+	if (Move.Flags & FPracticeNetMove::DroneToggle)
+	{
+		HandleMovementEvent(EPracticeMovementEvent::ToggleDrone);
+	}
+
+	if (Controller)
+	{
+		Controller->SetControlRotation(Move.GetControlRotation());
+		RefreshControlBasis();
+	}
+	InputDirection = Move.GetMoveInput().GetSafeNormal();
+	DroneThrustInput = Move.GetDroneThrust();
+
+	// 서버, 예측, 보정 후 재실행이 같은 결과를 내야 하므로 프레임마다 결과가 다른 비동기 Probe 대신 동기 지면 검사를 사용한다.
+	// ServerMove는 한 프레임에 여러 번 도착하고 보정 후 재실행은 한 프레임에 저장된 이동을 모두 다시 실행한다.
+	SimulateMovement(Move.GetDeltaTime(), false);
+}
+
+void APracticeCharacter::TickAutonomousProxy(float DeltaTime)
+{
 	UpdateControllerRotation(DeltaTime);
 
-	// 지상 이동
-	if (!bIsFall && !bIsJumping)
+	// 서버와 같은 값으로 시뮬레이션하기 위해서 ms 단위로 보내고 남은 시간은 다음 프레임에 보낸다.
+	ClientTimeRemainder += DeltaTime;
+	const int32 DeltaTimeMs = FMath::Min(FMath::FloorToInt32(ClientTimeRemainder * 1000.0f), static_cast<int32>(FPracticeNetMove::MaxDeltaTimeMs));
+	if (DeltaTimeMs <= 0 || !Controller)
 	{
-		FallSpeed = 0;
-		PlaneMove(DeltaTime);
+		UpdateCamera();
+		return;
 	}
-	// 공중 이동
-	else
+	// 최대 시간을 넘는 느린 프레임의 남은 시간은 버린다.
+	ClientTimeRemainder = FMath::Min(ClientTimeRemainder - DeltaTimeMs * 0.001f, 0.001f);
+	ClientTimeStamp += DeltaTimeMs;
+
+	FPracticeNetMove Move;
+	Move.TimeStamp = ClientTimeStamp;
+	Move.DeltaTimeMs = static_cast<uint8>(DeltaTimeMs);
+	Move.SetMoveInput(InputDirection);
+	Move.SetControlRotation(Controller->GetControlRotation());
+	Move.SetDroneThrust(DroneThrustInput);
+	if (PendingInputButtons & EPracticeInputButtons::Jump)
 	{
-		AirPlaneMove(DeltaTime);
+		Move.Flags |= FPracticeNetMove::Jump;
+	}
+	if (PendingInputButtons & EPracticeInputButtons::DroneToggle)
+	{
+		Move.Flags |= FPracticeNetMove::DroneToggle;
 	}
+	PendingInputButtons = 0;
 
-	Move(DeltaTime);
+	// 양자화된 입력으로 예측 이동
+	SimulateNetMove(Move);
+
+	SavedMoves.Add(Move);
+	const int32 NumOverflow = SavedMoves.Num() - CVarPracticeNetMaxSavedMoves.GetValueOnGameThread();
+	if (NumOverflow > 0)
+	{
+		SavedMoves.RemoveAt(0, NumOverflow, EAllowShrinking::No);
+	}
+
+	ServerMove(Move, GetActorLocation());
 
 	UpdateCamera();
 }
 
+void APracticeCharacter::ServerMove_Implementation(const FPracticeNetMove& Move, FVector_NetQuantize100 ClientLocation)
+{
+	// 순서가 바뀌었거나 중복된 입력
+	if (Move.TimeStamp <= ServerTimeStamp)
+	{
+		return;
+	}
+
+	// 클라이언트가 보낸 시간을 그대로 믿지 않는다.
+	// 1. TimeStamp는 DeltaTimeMs의 누적이므로 이전 입력과의 차이가 DeltaTimeMs와 같아야 한다. 입력이 빠진 경우도 거절하고 서버 상태로 보정한다.
+	// 2. 서버 시간만큼 쌓이는 예산보다 긴 입력은 거절한다. 한 프레임에 긴 입력을 여러 번 보내서 빨리 움직일 수 없다.
+	const bool bContiguous = Move.TimeStamp - ServerTimeStamp == Move.DeltaTimeMs;
+	ServerTimeStamp = Move.TimeStamp;
+	RefillMoveTimeBudget();
+	if (!bContiguous || Move.GetDeltaTime() > ServerMoveTimeBudget)
+	{
+		++NetRejectedMoveCount;
+		INC_DWORD_STAT(STAT_PracticeNetRejectedMoves);
+		SendNetCorrection(Move.TimeStamp);
+		ReportNetStats();
+		return;
+	}
+	ServerMoveTimeBudget -= Move.GetDeltaTime();
+
+	SimulateNetMove(Move);
+	++NetMoveCount;
+	INC_DWORD_STAT(STAT_PracticeNetMoves);
+
+	const float MaxLocationError = CVarPracticeNetMaxLocationError.GetValueOnGameThread();
+	if (FVector::DistSquared(GetActorLocation(), ClientLocation) > FMath::Square(MaxLocationError))
+	{
+		SendNetCorrection(Move.TimeStamp);
+	}
+	else
+	{
+		ClientAckMove(Move.TimeStamp);
+	}
+
+	ReportNetStats();
+}
+
+void APracticeCharacter::SendNetCorrection(uint32 TimeStamp)
+{
+	FPracticeNetCorrection Correction;
+	Correction.TimeStamp = TimeStamp;
+	Correction.Location = GetActorLocation();
+	Correction.Rotation = GetActorRotation();
+	Correction.Velocity = Velocity;
+	Correction.MoveDirection = MoveDirection;
+	Correction.FallSpeed = FallSpeed;
+	Correction.MovementMode = MovementMode;
+	Correction.StateTimeRemaining = StateTimeRemaining;
+	Correction.DroneVelocity = DroneVelocity;
+	ClientAdjustPosition(Correction);
+
+	++NetCorrectionCount;
+	INC_DWORD_STAT(STAT_PracticeNetCorrections);
+}
+
+void APracticeCharacter::RefillMoveTimeBudget()
+{
+	// 처음 받은 입력은 예산이 가득 찬 상태에서 시작한다.
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	const float MaxBudget = CVarPracticeNetMaxMoveTimeBudget.GetValueOnGameThread();
+	ServerMoveTimeBudget = ServerMoveBudgetTime < 0.0
+		? MaxBudget
+		: FMath::Min(ServerMoveTimeBudget + static_cast<float>(CurrentTime - ServerMoveBudgetTime), MaxBudget);
+	ServerMoveBudgetTime = CurrentTime;
+}
+
+void APracticeCharacter::RemoveAckedMoves(uint32 TimeStamp)
+{
+	ClientAckedTimeStamp = TimeStamp;
+
+	int32 NumAcked = 0;
+	while (NumAcked < SavedMoves.Num() && SavedMoves[NumAcked].TimeStamp <= TimeStamp)
+	{
+		++NumAcked;
+	}
+	SavedMoves.RemoveAt(0, NumAcked, EAllowShrinking::No);
+}
+
+void APracticeCharacter::ClientAckMove_Implementation(uint32 TimeStamp)
+{
+	if (TimeStamp > ClientAckedTimeStamp)
+	{
+		RemoveAckedMoves(TimeStamp);
+	}
+}
+
+void APracticeCharacter::ClientAdjustPosition_Implementation(const FPracticeNetCorrection& Correction)
+{
+	// 이미 더 최근 입력의 확인을 받았다면 오래된 보정이다.
+	if (Correction.TimeStamp <= ClientAckedTimeStamp)
+	{
+		return;
+	}
+	RemoveAckedMoves(Correction.TimeStamp);
+
+	// 1. 서버 상태 적용, Controller 회전과 처리하지 않은 회전 입력은 유지한다.
+	const FRotator CurrentControlRotation = Controller ? Controller->GetControlRotation() : FRotator::ZeroRotator;
+	const FRotator PendingCameraRotator = DeltaCameraRotator;
+
+	FPracticeMovementSnapshot Snapshot;
+	Snapshot.Location = Correction.Location;
+	Snapshot.Rotation = Correction.Rotation;
+	Snapshot.ControlRotation = CurrentControlRotation;
+	Snapshot.Velocity = Correction.Velocity;
+	Snapshot.MoveDirection = Correction.MoveDirection;
+	Snapshot.FallSpeed = Correction.FallSpeed;
+	Snapshot.MovementMode = Correction.MovementMode;
+	Snapshot.StateTimeRemaining = Correction.StateTimeRemaining;
+	// 이동 타이머는 보정에 담지 않는다. 짧은 입력 보조 시간이므로 클라이언트 값을 유지한다.
+	Snapshot.MovementTimers = MovementTimers;
+	Snapshot.DroneVelocity = Correction.DroneVelocity;
+	ApplyMovementSnapshot(Snapshot);
+
+	// 2. 서버가 아직 처리하지 않은 입력을 다시 시뮬레이션
+	for (const FPracticeNetMove& Move : SavedMoves)
+	{
+		SimulateNetMove(Move);
+	}
+
+	if (Controller)
+	{
+		Controller->SetControlRotation(CurrentControlRotation);
+		RefreshControlBasis();
+	}
+	DeltaCameraRotator = PendingCameraRotator;
+
+	++NetCorrectionCount;
+	INC_DWORD_STAT(STAT_PracticeNetCorrections);
+}
+
+void APracticeCharacter::OnRep_NetMovement()
+{
+	// Animation에서 읽는 값은 바로 적용하고 위치는 Tick에서 보간한다.
+	Velocity = NetMovement.Velocity;
+	if (MovementMode != NetMovement.MovementMode)
+	{
+		MovementMode = NetMovement.MovementMode;
+		UpdateMovementModeFlags();
+	}
+}
+
+void APracticeCharacter::TickSimulatedProxy(float DeltaTime)
+{
+	const FVector TargetLocation = NetMovement.Location;
+	const FVector CurrentLocation = GetActorLocation();
+
+	// 너무 멀면 보간하지 않고 바로 이동한다.
+	constexpr float MaxInterpDistance = 500.0f;
+	if (FVector::DistSquared(CurrentLocation, TargetLocation) > FMath::Square(MaxInterpDistance))
+	{
+		SetActorLocationAndRotation(TargetLocation, NetMovement.Rotation);
+		return;
+	}
+
+	SetActorLocationAndRotation(
+		FMath::VInterpTo(CurrentLocation, TargetLocation, DeltaTime, SimulatedInterpSpeed),
+		FMath::RInterpTo(GetActorRotation(), NetMovement.Rotation, DeltaTime, SimulatedInterpSpeed));
+}
+
+void APracticeCharacter::ReportNetStats()
+{
+	if (!CVarPracticeNetReport.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	if (NetReportStartTime <= 0.0)
+	{
+		NetReportStartTime = CurrentTime;
+		return;
+	}
+
+	const double Elapsed = CurrentTime - NetReportStartTime;
+	if (Elapsed < 1.0)
+	{
+		return;
+	}
+
+	const UNetConnection* Connection = GetNetConnection();
+	UE_LOG(LogPracticeMovement, Log, TEXT("Net %s : in %d B/s, out %d B/s, moves %.1f/s, corrections %.1f/s (%.1f%%), rejected %.1f/s"),
+		*GetNameSafe(Controller),
+		Connection ? Connection->InBytesPerSecond : 0,
+		Connection ? Connection->OutBytesPerSecond : 0,
+		NetMoveCount / Elapsed,
+		NetCorrectionCount / Elapsed,
+		NetMoveCount > 0 ? 100.0f * NetCorrectionCount / NetMoveCount : 0.0f,
+		NetRejectedMoveCount / Elapsed);
+
+	NetMoveCount = 0;
+	NetCorrectionCount = 0;
+	NetRejectedMoveCount = 0;
+	NetReportStartTime = CurrentTime;
+}
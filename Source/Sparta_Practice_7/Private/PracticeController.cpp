@@ -3,9 +3,14 @@
 
 #include "PracticeController.h"
 #include "EnhancedInputSubsystems.h"
+#include "Misc/CommandLine.h"
+#include "PracticeCameraManager.h"
+#include "PracticeCharacter.h"
+#include "Sparta_Practice_7.h"
 
 APracticeController::APracticeController()
 {
+	PlayerCameraManagerClass = APracticeCameraManager::StaticClass();
 }
 
 void APracticeController::BeginPlay()
@@ -22,4 +27,211 @@ void APracticeController::BeginPlay()
 			}
 		}
 	}
+
+	if (IsLocalController())
+	{
+		const TCHAR* CommandLine = FCommandLine::Get();
+		FString ReplayFileName;
+		if (FParse::Value(CommandLine, TEXT("PracticeReplay="), ReplayFileName))
+		{
+			float FixedStepRate = 0.0f;
+			if (FParse::Value(CommandLine, TEXT("PracticeReplayFixedStep="), FixedStepRate) && FixedStepRate > 0.0f)
+			{
+				ReplayFixedStep = 1.0f / FixedStepRate;
+			}
+			FParse::Value(CommandLine, TEXT("PracticeReplayGolden="), GoldenFileName);
+			bUpdateGolden = FParse::Param(CommandLine, TEXT("PracticeReplayUpdateGolden"));
+
+			PracticeReplay(ReplayFileName);
+		}
+	}
+}
+
+void APracticeController::PlayerTick(float DeltaTime)
+{
+	// 입력 처리 후에 Pawn의 입력 상태를 기록한다. Pawn의 Tick은 Controller 다음에 실행된다.
+	Super::PlayerTick(DeltaTime);
+
+	if (bReplayPending)
+	{
+		StartReplay();
+	}
+
+	if (bIsReplaying)
+	{
+		ReplayFrame();
+	}
+	else if (bIsRecording)
+	{
+		RecordFrame(DeltaTime);
+	}
+}
+
+void APracticeController::PracticeRecordStart(const FString& FileName)
+{
+	APracticeCharacter* PracticeCharacter = GetPawn<APracticeCharacter>();
+	if (!PracticeCharacter || bIsReplaying)
+	{
+		UE_LOG(LogPracticeMovement, Warning, TEXT("Record : no practice pawn or replay in progress"));
+		return;
+	}
+
+	Recording = FPracticeInputRecording();
+	Recording.StartState = PracticeCharacter->GetMovementSnapshot();
+	RecordingFileName = FileName.IsEmpty() ? FDateTime::Now().ToString() + TEXT(".pinput") : FileName;
+	bIsRecording = true;
+
+	UE_LOG(LogPracticeMovement, Display, TEXT("Record : started %s"), *RecordingFileName);
+}
+
+void APracticeController::PracticeRecordStop()
+{
+	if (!bIsRecording)
+	{
+		return;
+	}
+	bIsRecording = false;
+
+	const bool bSaved = Recording.Save(RecordingFileName);
+	UE_LOG(LogPracticeMovement, Display, TEXT("Record : %d frames, %s %s"),
+		Recording.Frames.Num(), bSaved ? TEXT("saved to") : TEXT("failed to save"), *FPracticeInputRecording::ResolvePath(RecordingFileName));
+	Recording = FPracticeInputRecording();
+}
+
+void APracticeController::RecordFrame(float DeltaTime)
+{
+	APracticeCharacter* PracticeCharacter = GetPawn<APracticeCharacter>();
+	if (!PracticeCharacter)
+	{
+		PracticeRecordStop();
+		return;
+	}
+
+	FPracticeInputFrame& Frame = Recording.Frames.AddDefaulted_GetRef();
+	Frame.DeltaTime = DeltaTime;
+	Frame.MoveInput = FVector2f(PracticeCharacter->GetInputDirection());
+	Frame.LookInput = FRotator3f(PracticeCharacter->DeltaCameraRotator);
+	Frame.DroneThrustInput = PracticeCharacter->GetDroneThrustInput();
+	Frame.Buttons = PracticeCharacter->GetPendingInputButtons();
+}
+
+void APracticeController::PracticeReplay(const FString& FileName)
+{
+	if (bIsRecording)
+	{
+		PracticeRecordStop();
+	}
+
+	if (!Recording.Load(FileName))
+	{
+		UE_LOG(LogPracticeMovement, Error, TEXT("Replay : failed to load %s"), *FPracticeInputRecording::ResolvePath(FileName));
+		return;
+	}
+
+	UE_LOG(LogPracticeMovement, Display, TEXT("Replay : %s, %d frames"), *FileName, Recording.Frames.Num());
+	bReplayPending = true;
+}
+
+void APracticeController::StartReplay()
+{
+	APracticeCharacter* PracticeCharacter = GetPawn<APracticeCharacter>();
+	if (!PracticeCharacter)
+	{
+		// Possess 될 때까지 기다린다.
+		return;
+	}
+	bReplayPending = false;
+
+	// 실제 입력과 Pawn의 Tick을 끄고 Controller에서 직접 진행한다.
+	DisableInput(this);
+	PracticeCharacter->DisableInput(this);
+	PracticeCharacter->SetExternalStepping(true);
+	PracticeCharacter->ApplyMovementSnapshot(Recording.StartState);
+
+	ReplayFrameIndex = 0;
+	bIsReplaying = true;
+}
+
+void APracticeController::ReplayFrame()
+{
+	APracticeCharacter* PracticeCharacter = GetPawn<APracticeCharacter>();
+	if (!PracticeCharacter || !Recording.Frames.IsValidIndex(ReplayFrameIndex))
+	{
+		FinishReplay();
+		return;
+	}
+
+	// 입력 콜백, Pawn Tick과 같은 순서로 넣는다.
+	const FPracticeInputFrame& Frame = Recording.Frames[ReplayFrameIndex++];
+	PracticeCharacter->SetMoveInput(FVector2D(Frame.MoveInput));
+	PracticeCharacter->SetDroneThrustInput(Frame.DroneThrustInput);
+	PracticeCharacter->DeltaCameraRotator = FRotator(Frame.LookInput);
+	if (Frame.Buttons & EPracticeInputButtons::Jump)
+	{
+		PracticeCharacter->RequestJump();
+	}
+	if (Frame.Buttons & EPracticeInputButtons::DroneToggle)
+	{
+		PracticeCharacter->RequestToggleDrone();
+	}
+
+	PracticeCharacter->TickMovement(ReplayFixedStep > 0.0f ? ReplayFixedStep : Frame.DeltaTime);
+
+	if (ReplayFrameIndex >= Recording.Frames.Num())
+	{
+		FinishReplay();
+	}
+}
+
+void APracticeController::FinishReplay()
+{
+	bIsReplaying = false;
+
+	APracticeCharacter* PracticeCharacter = GetPawn<APracticeCharacter>();
+	if (PracticeCharacter)
+	{
+		PracticeCharacter->SetExternalStepping(false);
+		PracticeCharacter->EnableInput(this);
+	}
+	EnableInput(this);
+
+	UE_LOG(LogPracticeMovement, Display, TEXT("Replay : finished after %d frames"), ReplayFrameIndex);
+
+	if (GoldenFileName.IsEmpty() || !PracticeCharacter)
+	{
+		return;
+	}
+
+	// Golden 비교 결과는 종료 코드로 반환한다.
+	const FPracticeMovementSnapshot Result = PracticeCharacter->GetMovementSnapshot();
+	uint8 ExitCode = 0;
+	if (bUpdateGolden)
+	{
+		const bool bSaved = FPracticeInputRecording::SaveSnapshot(GoldenFileName, Result);
+		UE_LOG(LogPracticeMovement, Display, TEXT("Replay : golden %s %s"), bSaved ? TEXT("written to") : TEXT("failed to write"), *GoldenFileName);
+		ExitCode = bSaved ? 0 : 2;
+	}
+	else
+	{
+		FPracticeMovementSnapshot Golden;
+		if (!FPracticeInputRecording::LoadSnapshot(GoldenFileName, Golden))
+		{
+			UE_LOG(LogPracticeMovement, Error, TEXT("Replay : failed to load golden %s"), *GoldenFileName);
+			ExitCode = 2;
+		}
+		else if (Result.IsBitwiseEqual(Golden))
+		{
+			UE_LOG(LogPracticeMovement, Display, TEXT("Replay : matches golden"));
+		}
+		else
+		{
+			UE_LOG(LogPracticeMovement, Error, TEXT("Replay : mismatch, location %s (golden %s, distance %g), rotation %s (golden %s), mode %d (golden %d)"),
+				*Result.Location.ToString(), *Golden.Location.ToString(), FVector::Dist(Result.Location, Golden.Location),
+				*Result.Rotation.ToString(), *Golden.Rotation.ToString(),
+				static_cast<int32>(Result.MovementMode), static_cast<int32>(Golden.MovementMode));
+			ExitCode = 1;
+		}
+	}
+
+	FPlatformMisc::RequestExitWithStatus(false, ExitCode, TEXT("PracticeReplay"));
 }
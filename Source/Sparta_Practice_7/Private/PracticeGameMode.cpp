@@ -5,9 +5,125 @@
 
 #include "PracticeCharacter.h"
 #include "PracticeController.h"
+#include "PracticeMovementStats.h"
+#include "Sparta_Practice_7.h"
+
+DEFINE_STAT(STAT_PracticePawnAcquire);
+DEFINE_STAT(STAT_PracticePawnPoolHits);
+DEFINE_STAT(STAT_PracticePawnPoolMisses);
+DEFINE_STAT(STAT_PracticePawnPoolAvailable);
 
 APracticeGameMode::APracticeGameMode()
 {
 	DefaultPawnClass = APracticeCharacter::StaticClass();
 	PlayerControllerClass = APracticeController::StaticClass();
+
+	PawnPoolSize = 0;
+	PooledPawnClass = APracticeCharacter::StaticClass();
+	PoolParkingLocation = FVector(0.0f, 0.0f, -100000.0f);
+}
+
+void APracticeGameMode::BeginPlay()
+{
+	Super::BeginPlay();
+
+	FParse::Value(FCommandLine::Get(), TEXT("PracticePawnPool="), PawnPoolSize);
+	PawnPoolSize = FMath::Max(PawnPoolSize, 0);
+
+	// 미리 만들어 두고 바로 풀에 넣는다.
+	PawnPool.Reserve(PawnPoolSize);
+	const FTransform ParkingTransform(PoolParkingLocation);
+	for (int32 Index = 0; Index < PawnPoolSize; ++Index)
+	{
+		if (APracticeCharacter* Pawn = SpawnPooledPawn(ParkingTransform))
+		{
+			Pawn->DeactivateForPool(PoolParkingLocation);
+			PawnPool.Add(Pawn);
+		}
+	}
+	SET_DWORD_STAT(STAT_PracticePawnPoolAvailable, PawnPool.Num());
+}
+
+void APracticeGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ReportPoolStats();
+	PawnPool.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+APracticeCharacter* APracticeGameMode::AcquirePawn(const FTransform& SpawnTransform)
+{
+	PRACTICE_MOVEMENT_STAT_SCOPE(PawnAcquire);
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Level 전환 등으로 없어진 Pawn은 건너뛴다.
+	APracticeCharacter* Pawn = nullptr;
+	while (!Pawn && PawnPool.Num() > 0)
+	{
+		Pawn = PawnPool.Pop(EAllowShrinking::No);
+		if (!IsValid(Pawn))
+		{
+			Pawn = nullptr;
+		}
+	}
+
+	if (Pawn)
+	{
+		Pawn->ActivateFromPool(SpawnTransform);
+
+		++PoolHitCount;
+		PoolHitSeconds += FPlatformTime::Seconds() - StartTime;
+		INC_DWORD_STAT(STAT_PracticePawnPoolHits);
+	}
+	else
+	{
+		Pawn = SpawnPooledPawn(SpawnTransform);
+
+		++PoolMissCount;
+		PoolMissSeconds += FPlatformTime::Seconds() - StartTime;
+		INC_DWORD_STAT(STAT_PracticePawnPoolMisses);
+	}
+
+	SET_DWORD_STAT(STAT_PracticePawnPoolAvailable, PawnPool.Num());
+	return Pawn;
+}
+
+void APracticeGameMode::ReleasePawn(APracticeCharacter* Pawn)
+{
+	if (!IsValid(Pawn) || Pawn->IsPooled())
+	{
+		return;
+	}
+
+	if (AController* PawnController = Pawn->GetController())
+	{
+		PawnController->UnPossess();
+	}
+	Pawn->DeactivateForPool(PoolParkingLocation);
+	PawnPool.Add(Pawn);
+
+	SET_DWORD_STAT(STAT_PracticePawnPoolAvailable, PawnPool.Num());
+}
+
+APracticeCharacter* APracticeGameMode::SpawnPooledPawn(const FTransform& SpawnTransform)
+{
+	UClass* PawnClass = PooledPawnClass ? PooledPawnClass.Get() : APracticeCharacter::StaticClass();
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	return GetWorld()->SpawnActor<APracticeCharacter>(PawnClass, SpawnTransform, SpawnParams);
+}
+
+void APracticeGameMode::ReportPoolStats() const
+{
+	if (PoolHitCount + PoolMissCount == 0)
+	{
+		return;
+	}
+
+	UE_LOG(LogPracticeMovement, Log, TEXT("Pawn pool : size %d, hits %d (avg %.3f ms), misses %d (avg %.3f ms)"),
+		PawnPoolSize,
+		PoolHitCount, PoolHitCount > 0 ? PoolHitSeconds * 1000.0 / PoolHitCount : 0.0,
+		PoolMissCount, PoolMissCount > 0 ? PoolMissSeconds * 1000.0 / PoolMissCount : 0.0);
 }
@@ -0,0 +1,549 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PracticeGroundCacheSubsystem.h"
+
+#include "Async/MappedFileHandle.h"
+#include "Components/PrimitiveComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/PlatformFileManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "PracticeMovementStats.h"
+#include "Sparta_Practice_7.h"
+
+DEFINE_STAT(STAT_PracticeGroundCacheQuery);
+DEFINE_STAT(STAT_PracticeGroundCacheHits);
+DEFINE_STAT(STAT_PracticeGroundCacheMisses);
+DEFINE_STAT(STAT_PracticeGroundCacheMemory);
+
+static TAutoConsoleVariable<int32> CVarPracticeGroundCacheEnable(
+	TEXT("practice.GroundCache.Enable"),
+	0,
+	TEXT("정적인 Level의 지면 높이 캐시를 사용한다. Level을 시작할 때 적용된다.\n")
+	TEXT("0: 물리 Trace만 사용, 1: 캐시로 답할 수 있으면 캐시 사용"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPracticeGroundCacheCellSize(
+	TEXT("practice.GroundCache.CellSize"),
+	50.0f,
+	TEXT("격자 한 칸의 크기(cm), 셀 수가 MaxCells를 넘으면 두 배씩 키운다."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarPracticeGroundCacheMaxCells(
+	TEXT("practice.GroundCache.MaxCells"),
+	4 * 1024 * 1024,
+	TEXT("캐시의 최대 셀 수"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPracticeGroundCacheTolerance(
+	TEXT("practice.GroundCache.Tolerance"),
+	0.25f,
+	TEXT("평면으로 볼 수 있는 높이 오차(cm), 판정 경계에서 이 거리 안이면 물리 Trace를 사용한다."),
+	ECVF_Default);
+
+static FAutoConsoleCommandWithWorld PracticeGroundCacheRebuildCommand(
+	TEXT("practice.GroundCache.Rebuild"),
+	TEXT("지면 높이 캐시 파일을 다시 만든다."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UPracticeGroundCacheSubsystem* GroundCache = World ? World->GetSubsystem<UPracticeGroundCacheSubsystem>() : nullptr)
+		{
+			GroundCache->Rebuild();
+		}
+	}));
+
+namespace PracticeGroundCache
+{
+	// IsOnGround의 Trace(ECC_Visibility)가 충돌하는 Primitive
+	bool BlocksGroundTrace(const UPrimitiveComponent* Component)
+	{
+		return Component->IsQueryCollisionEnabled() && Component->GetCollisionResponseToChannel(ECC_Visibility) == ECR_Block;
+	}
+
+	// 위에서 아래로 정적 Collision만 Trace한다.
+	bool TraceStatic(const UWorld* World, const FVector2D& Location, const FVector2D& ZRange, float& OutHeight, FVector3f& OutNormal)
+	{
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(PracticeGroundCacheBuild), false);
+		QueryParams.MobilityType = EQueryMobilityType::Static;
+
+		FHitResult Hit;
+		if (!World->LineTraceSingleByChannel(Hit, FVector(Location, ZRange.Y), FVector(Location, ZRange.X), ECC_Visibility, QueryParams))
+		{
+			return false;
+		}
+		OutHeight = Hit.ImpactPoint.Z;
+		OutNormal = FVector3f(Hit.ImpactNormal);
+		return true;
+	}
+
+	// Bounds가 같아도 Mesh, Collision, 회전이 바뀌면 지면이 달라지므로 함께 Hash한다.
+	uint32 HashComponent(const UPrimitiveComponent* Component, const FBox& Box)
+	{
+		uint32 Hash = FCrc::MemCrc32(&Box.Min, sizeof(Box.Min), FCrc::MemCrc32(&Box.Max, sizeof(Box.Max)));
+
+		const FTransform& Transform = Component->GetComponentTransform();
+		const FVector Location = Transform.GetLocation();
+		const FQuat Rotation = Transform.GetRotation();
+		const FVector Scale = Transform.GetScale3D();
+		Hash = FCrc::MemCrc32(&Location, sizeof(Location), Hash);
+		Hash = FCrc::MemCrc32(&Rotation, sizeof(Rotation), Hash);
+		Hash = FCrc::MemCrc32(&Scale, sizeof(Scale), Hash);
+
+		// Static Mesh는 Asset 경로와 Collision의 Guid, 그 밖의 Primitive는 Class로 구분한다.
+		// Shape Component의 Body Setup은 실행할 때마다 새로 만들어지므로 Hash하지 않는다.
+		const UStaticMeshComponent* MeshComponent = Cast<UStaticMeshComponent>(Component);
+		if (const UStaticMesh* Mesh = MeshComponent ? MeshComponent->GetStaticMesh() : nullptr)
+		{
+			Hash = FCrc::StrCrc32(*Mesh->GetPathName(), Hash);
+			if (const UBodySetup* BodySetup = Mesh->GetBodySetup())
+			{
+				Hash = HashCombine(Hash, GetTypeHash(BodySetup->BodySetupGuid));
+			}
+		}
+		else
+		{
+			Hash = FCrc::StrCrc32(*Component->GetClass()->GetPathName(), Hash);
+		}
+		return Hash;
+	}
+
+	uint8 QuantizeNormalZ(float NormalZ)
+	{
+		return static_cast<uint8>(1 + FMath::RoundToInt32(FMath::Clamp(NormalZ, 0.0f, 1.0f) * 254.0f));
+	}
+
+	// 양자화 오차를 고려한 가장 작은 Normal Z
+	float GetMinNormalZ(uint8 Quantized)
+	{
+		return (Quantized - 1.5f) / 254.0f;
+	}
+}
+
+bool UPracticeGroundCacheSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UPracticeGroundCacheSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (!CVarPracticeGroundCacheEnable.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	FBox Bounds;
+	const uint32 GeometryHash = ComputeGeometryHash(Bounds);
+	if (!Bounds.IsValid)
+	{
+		UE_LOG(LogPracticeMovement, Warning, TEXT("GroundCache : no static collision in %s"), *InWorld.GetMapName());
+		return;
+	}
+
+	const FString Path = GetCachePath();
+	if (!Load(Path, GeometryHash))
+	{
+		Unload();
+		if (!Build(Path, Bounds, GeometryHash) || !Load(Path, GeometryHash))
+		{
+			Unload();
+			return;
+		}
+	}
+
+	MarkDynamicPrimitives();
+	ReportQuerySpeed();
+}
+
+void UPracticeGroundCacheSubsystem::Deinitialize()
+{
+	Unload();
+	MarkedBounds.Empty();
+
+	Super::Deinitialize();
+}
+
+void UPracticeGroundCacheSubsystem::Rebuild()
+{
+	FBox Bounds;
+	const uint32 GeometryHash = ComputeGeometryHash(Bounds);
+	const FString Path = GetCachePath();
+
+	// 열려 있는 파일은 덮어쓸 수 없으므로 먼저 닫는다.
+	Unload();
+	if (!Bounds.IsValid || !Build(Path, Bounds, GeometryHash) || !Load(Path, GeometryHash))
+	{
+		Unload();
+		return;
+	}
+
+	MarkDynamicPrimitives();
+	ReportQuerySpeed();
+}
+
+FString UPracticeGroundCacheSubsystem::GetCachePath() const
+{
+	return FPaths::ProjectSavedDir() / TEXT("GroundCache") / GetWorld()->GetMapName() + TEXT(".pgc");
+}
+
+uint32 UPracticeGroundCacheSubsystem::ComputeGeometryHash(FBox& OutBounds) const
+{
+	OutBounds.Init();
+
+	// Actor 순서와 관계없도록 Component별 Hash를 더한다.
+	uint32 Hash = 0;
+	for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+	{
+		It->ForEachComponent<UPrimitiveComponent>(false, [&OutBounds, &Hash](const UPrimitiveComponent* Component)
+		{
+			if (Component->Mobility != EComponentMobility::Static || !PracticeGroundCache::BlocksGroundTrace(Component))
+			{
+				return;
+			}
+			const FBox Box = Component->Bounds.GetBox();
+			OutBounds += Box;
+			Hash += PracticeGroundCache::HashComponent(Component, Box);
+		});
+	}
+
+	// 설정이 바뀌어도 다시 만든다.
+	Hash = HashCombine(Hash, GetTypeHash(CVarPracticeGroundCacheCellSize.GetValueOnGameThread()));
+	Hash = HashCombine(Hash, GetTypeHash(CVarPracticeGroundCacheTolerance.GetValueOnGameThread()));
+	return Hash;
+}
+
+bool UPracticeGroundCacheSubsystem::Build(const FString& Path, const FBox& Bounds, uint32 GeometryHash)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	const UWorld* World = GetWorld();
+
+	FHeader NewHeader;
+	NewHeader.Magic = Magic;
+	NewHeader.Version = Version;
+	NewHeader.GeometryHash = GeometryHash;
+	NewHeader.Tolerance = FMath::Max(CVarPracticeGroundCacheTolerance.GetValueOnGameThread(), 0.0f);
+	NewHeader.OriginX = Bounds.Min.X;
+	NewHeader.OriginY = Bounds.Min.Y;
+
+	const int64 MaxCells = FMath::Max(CVarPracticeGroundCacheMaxCells.GetValueOnGameThread(), 1);
+	NewHeader.CellSize = FMath::Max(CVarPracticeGroundCacheCellSize.GetValueOnGameThread(), 1.0f);
+	while (true)
+	{
+		NewHeader.NumX = FMath::Max(FMath::CeilToInt32((Bounds.Max.X - Bounds.Min.X) / NewHeader.CellSize), 1);
+		NewHeader.NumY = FMath::Max(FMath::CeilToInt32((Bounds.Max.Y - Bounds.Min.Y) / NewHeader.CellSize), 1);
+		if (static_cast<int64>(NewHeader.NumX) * NewHeader.NumY <= MaxCells)
+		{
+			break;
+		}
+		NewHeader.CellSize *= 2.0f;
+	}
+
+	const int32 NumVertsX = NewHeader.NumX + 1;
+	const int64 NumVerts = static_cast<int64>(NumVertsX) * (NewHeader.NumY + 1);
+	const int64 NumCells = static_cast<int64>(NewHeader.NumX) * NewHeader.NumY;
+
+	TArray64<uint8> Data;
+	Data.SetNumZeroed(sizeof(FHeader) + NumVerts * sizeof(float) + NumCells);
+	FMemory::Memcpy(Data.GetData(), &NewHeader, sizeof(FHeader));
+	float* OutHeights = reinterpret_cast<float*>(Data.GetData() + sizeof(FHeader));
+	uint8* OutNormals = Data.GetData() + sizeof(FHeader) + NumVerts * sizeof(float);
+
+	const FVector2D ZRange(Bounds.Min.Z - 100.0f, Bounds.Max.Z + 100.0f);
+	const auto GetVertexLocation = [&NewHeader](int32 X, int32 Y)
+	{
+		return FVector2D(NewHeader.OriginX + X * NewHeader.CellSize, NewHeader.OriginY + Y * NewHeader.CellSize);
+	};
+
+	// 1. 꼭짓점 높이, Trace가 없으면 셀을 사용하지 않는다.
+	TBitArray<> ValidVerts(false, NumVerts);
+	TArray64<FVector3f> VertexNormals;
+	VertexNormals.SetNumZeroed(NumVerts);
+	for (int32 Y = 0; Y <= NewHeader.NumY; ++Y)
+	{
+		for (int32 X = 0; X < NumVertsX; ++X)
+		{
+			const int64 Vert = X + static_cast<int64>(Y) * NumVertsX;
+			ValidVerts[Vert] = PracticeGroundCache::TraceStatic(World, GetVertexLocation(X, Y), ZRange, OutHeights[Vert], VertexNormals[Vert]);
+		}
+	}
+
+	// 2. 셀 중심과 비교해서 평면인 셀만 사용한다. 계단 모서리나 꺾이는 곳은 물리 Trace를 사용한다.
+	int64 NumUsableCells = 0;
+	for (int32 Y = 0; Y < NewHeader.NumY; ++Y)
+	{
+		for (int32 X = 0; X < NewHeader.NumX; ++X)
+		{
+			const int64 Cell = X + static_cast<int64>(Y) * NewHeader.NumX;
+			const int64 Corners[4] = { X + static_cast<int64>(Y) * NumVertsX, X + 1 + static_cast<int64>(Y) * NumVertsX,
+				X + static_cast<int64>(Y + 1) * NumVertsX, X + 1 + static_cast<int64>(Y + 1) * NumVertsX };
+			if (!ValidVerts[Corners[0]] || !ValidVerts[Corners[1]] || !ValidVerts[Corners[2]] || !ValidVerts[Corners[3]])
+			{
+				continue;
+			}
+
+			float CenterHeight;
+			FVector3f CenterNormal;
+			const FVector2D Center = GetVertexLocation(X, Y) + FVector2D(NewHeader.CellSize * 0.5f);
+			if (!PracticeGroundCache::TraceStatic(World, Center, ZRange, CenterHeight, CenterNormal))
+			{
+				continue;
+			}
+
+			const float BilinearHeight = (OutHeights[Corners[0]] + OutHeights[Corners[1]] + OutHeights[Corners[2]] + OutHeights[Corners[3]]) * 0.25f;
+			bool bPlanar = FMath::Abs(BilinearHeight - CenterHeight) <= NewHeader.Tolerance;
+			for (const int64 Corner : Corners)
+			{
+				bPlanar &= (VertexNormals[Corner] | CenterNormal) >= 0.999f;
+			}
+
+			if (bPlanar && CenterNormal.Z > 0.0f)
+			{
+				OutNormals[Cell] = PracticeGroundCache::QuantizeNormalZ(CenterNormal.Z);
+				++NumUsableCells;
+			}
+		}
+	}
+
+	FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*FPaths::GetPath(Path));
+	if (!FFileHelper::SaveArrayToFile(Data, *Path))
+	{
+		UE_LOG(LogPracticeMovement, Warning, TEXT("GroundCache : failed to write %s"), *Path);
+		return false;
+	}
+
+	UE_LOG(LogPracticeMovement, Display, TEXT("GroundCache : built %s, %d x %d cells of %.0f cm, %lld usable (%.1f%%), %.1f KB, %.2f s"),
+		*Path, NewHeader.NumX, NewHeader.NumY, NewHeader.CellSize, NumUsableCells, NumCells > 0 ? 100.0 * NumUsableCells / NumCells : 0.0,
+		Data.Num() / 1024.0, FPlatformTime::Seconds() - StartTime);
+	return true;
+}
+
+bool UPracticeGroundCacheSubsystem::Load(const FString& Path, uint32 GeometryHash)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const int64 FileSize = PlatformFile.FileSize(*Path);
+	if (FileSize < static_cast<int64>(sizeof(FHeader)))
+	{
+		return false;
+	}
+
+	const uint8* Data = nullptr;
+	MappedHandle.Reset(PlatformFile.OpenMapped(*Path));
+	if (MappedHandle)
+	{
+		MappedRegion.Reset(MappedHandle->MapRegion(0, FileSize));
+	}
+	if (MappedRegion)
+	{
+		Data = MappedRegion->GetMappedPtr();
+	}
+	else if (FFileHelper::LoadFileToArray(LoadedData, *Path))
+	{
+		Data = LoadedData.GetData();
+	}
+	if (!Data)
+	{
+		return false;
+	}
+
+	FMemory::Memcpy(&Header, Data, sizeof(FHeader));
+	const int64 NumVerts = static_cast<int64>(Header.NumX + 1) * (Header.NumY + 1);
+	const int64 NumCells = static_cast<int64>(Header.NumX) * Header.NumY;
+	if (Header.Magic != Magic || Header.Version != Version || Header.GeometryHash != GeometryHash
+		|| Header.NumX <= 0 || Header.NumY <= 0 || FileSize != static_cast<int64>(sizeof(FHeader)) + NumVerts * static_cast<int64>(sizeof(float)) + NumCells)
+	{
+		UE_LOG(LogPracticeMovement, Display, TEXT("GroundCache : %s is missing or stale, rebuilding"), *Path);
+		return false;
+	}
+
+	Heights = reinterpret_cast<const float*>(Data + sizeof(FHeader));
+	CellNormals = Data + sizeof(FHeader) + NumVerts * sizeof(float);
+	DynamicCells.Init(false, NumCells);
+
+	SET_MEMORY_STAT(STAT_PracticeGroundCacheMemory, FileSize);
+	UE_LOG(LogPracticeMovement, Display, TEXT("GroundCache : loaded %s (%s), %.1f KB"),
+		*Path, MappedRegion ? TEXT("mapped") : TEXT("read"), FileSize / 1024.0);
+	return true;
+}
+
+void UPracticeGroundCacheSubsystem::Unload()
+{
+	Heights = nullptr;
+	CellNormals = nullptr;
+	DynamicCells.Empty();
+	MappedRegion.Reset();
+	MappedHandle.Reset();
+	LoadedData.Empty();
+	Header = FHeader();
+	SET_MEMORY_STAT(STAT_PracticeGroundCacheMemory, 0);
+}
+
+void UPracticeGroundCacheSubsystem::MarkDynamicPrimitives()
+{
+	// Pawn은 지면 검사에서 무시한다.
+	for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+	{
+		if (It->IsA<APawn>())
+		{
+			continue;
+		}
+		It->ForEachComponent<UPrimitiveComponent>(false, [this](const UPrimitiveComponent* Component)
+		{
+			if (Component->Mobility != EComponentMobility::Static && PracticeGroundCache::BlocksGroundTrace(Component))
+			{
+				MarkDynamicCells(Component->Bounds.GetBox());
+			}
+		});
+	}
+
+	// 다시 만들면 표시가 지워지므로 MarkDynamic으로 지정한 영역도 다시 표시한다.
+	for (const FBox& Bounds : MarkedBounds)
+	{
+		MarkDynamicCells(Bounds);
+	}
+}
+
+void UPracticeGroundCacheSubsystem::MarkDynamic(const FBox& Bounds)
+{
+	if (!Bounds.IsValid)
+	{
+		return;
+	}
+
+	// 캐시를 읽기 전에 호출되어도 읽은 뒤에 표시한다.
+	MarkedBounds.Add(Bounds);
+	MarkDynamicCells(Bounds);
+}
+
+void UPracticeGroundCacheSubsystem::MarkDynamicCells(const FBox& Bounds)
+{
+	if (!IsReady() || !Bounds.IsValid)
+	{
+		return;
+	}
+
+	const int32 MinX = FMath::Clamp(FMath::FloorToInt32((Bounds.Min.X - Header.OriginX) / Header.CellSize), 0, Header.NumX - 1);
+	const int32 MaxX = FMath::Clamp(FMath::FloorToInt32((Bounds.Max.X - Header.OriginX) / Header.CellSize), 0, Header.NumX - 1);
+	const int32 MinY = FMath::Clamp(FMath::FloorToInt32((Bounds.Min.Y - Header.OriginY) / Header.CellSize), 0, Header.NumY - 1);
+	const int32 MaxY = FMath::Clamp(FMath::FloorToInt32((Bounds.Max.Y - Header.OriginY) / Header.CellSize), 0, Header.NumY - 1);
+	for (int32 Y = MinY; Y <= MaxY; ++Y)
+	{
+		for (int32 X = MinX; X <= MaxX; ++X)
+		{
+			DynamicCells[X + Y * Header.NumX] = true;
+		}
+	}
+}
+
+bool UPracticeGroundCacheSubsystem::QueryGround(const FVector& FootLocation, float CheckDistance, float WalkableNormalZ, bool& bOutOnGround) const
+{
+	if (!IsReady())
+	{
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_PracticeGroundCacheQuery);
+
+	const float CellX = (FootLocation.X - Header.OriginX) / Header.CellSize;
+	const float CellY = (FootLocation.Y - Header.OriginY) / Header.CellSize;
+	const int32 X = FMath::FloorToInt32(CellX);
+	const int32 Y = FMath::FloorToInt32(CellY);
+	if (X < 0 || Y < 0 || X >= Header.NumX || Y >= Header.NumY)
+	{
+		INC_DWORD_STAT(STAT_PracticeGroundCacheMisses);
+		return false;
+	}
+
+	// 가파른 셀은 벽 판정, 미끄러짐 처리와 결과를 맞추기 위해 물리 Trace를 사용한다.
+	const int32 Cell = X + Y * Header.NumX;
+	const uint8 Normal = CellNormals[Cell];
+	if (Normal == UnusableCell || DynamicCells[Cell] || PracticeGroundCache::GetMinNormalZ(Normal) < WalkableNormalZ)
+	{
+		INC_DWORD_STAT(STAT_PracticeGroundCacheMisses);
+		return false;
+	}
+
+	const int32 NumVertsX = Header.NumX + 1;
+	const float* Row0 = Heights + X + static_cast<int64>(Y) * NumVertsX;
+	const float* Row1 = Row0 + NumVertsX;
+	const float AlphaX = CellX - X;
+	const float Height = FMath::Lerp(FMath::Lerp(Row0[0], Row0[1], AlphaX), FMath::Lerp(Row1[0], Row1[1], AlphaX), CellY - Y);
+
+	// Trace 구간 [Foot - CheckDistance, Foot] 안에 지면이 있는지 확인한다.
+	// 정적 지면이 구간 안에 있으면 그 위에 무엇이 있어도 Trace는 충돌하므로 캐시로 답한다.
+	// 지면보다 떠 있는 경우는 나중에 생기거나 움직인 물체가 발밑에 있을 수 있으므로 물리 Trace를 사용한다.
+	// 오차 범위 안에서 판정이 바뀔 수 있는 경우와 지면보다 아래(다리 밑 등)에 있는 경우도 물리 Trace를 사용한다.
+	const float Gap = FootLocation.Z - Height;
+	if (Gap < -Header.Tolerance || Gap >= CheckDistance - Header.Tolerance)
+	{
+		INC_DWORD_STAT(STAT_PracticeGroundCacheMisses);
+		return false;
+	}
+
+	INC_DWORD_STAT(STAT_PracticeGroundCacheHits);
+	bOutOnGround = true;
+	return true;
+}
+
+void UPracticeGroundCacheSubsystem::ReportQuerySpeed() const
+{
+#if !UE_BUILD_SHIPPING
+	// 셀 위의 임의의 위치에서 지면 바로 위와 조금 높은 위치를 같은 조건의 Trace와 비교한다.
+	constexpr int32 NumSamples = 10000;
+	constexpr float CheckDistance = 1.0f;
+	const float WalkableNormalZ = FMath::Cos(FMath::DegreesToRadians(45.0f));
+
+	const UWorld* World = GetWorld();
+	FRandomStream Random(0);
+	TArray<FVector> Samples;
+	Samples.Reserve(NumSamples);
+	for (int32 Index = 0; Index < NumSamples; ++Index)
+	{
+		const float X = Header.OriginX + Random.FRand() * Header.NumX * Header.CellSize;
+		const float Y = Header.OriginY + Random.FRand() * Header.NumY * Header.CellSize;
+		float Height;
+		FVector3f Normal;
+		if (PracticeGroundCache::TraceStatic(World, FVector2D(X, Y), FVector2D(-UE_OLD_HALF_WORLD_MAX, UE_OLD_HALF_WORLD_MAX), Height, Normal))
+		{
+			Samples.Emplace(X, Y, Height + (Index % 2 == 0 ? 0.5f : 20.0f));
+		}
+	}
+	if (Samples.IsEmpty())
+	{
+		return;
+	}
+
+	int32 NumHits = 0;
+	TArray<int8> CacheResults;
+	CacheResults.SetNumUninitialized(Samples.Num());
+	const uint64 CacheStart = FPlatformTime::Cycles64();
+	for (int32 Index = 0; Index < Samples.Num(); ++Index)
+	{
+		bool bOnGround = false;
+		const bool bHit = QueryGround(Samples[Index], CheckDistance, WalkableNormalZ, bOnGround);
+		CacheResults[Index] = bHit ? static_cast<int8>(bOnGround) : -1;
+		NumHits += bHit;
+	}
+	const double CacheUs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - CacheStart) * 1000.0 / Samples.Num();
+
+	int32 NumMismatches = 0;
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(PracticeGroundCacheReport), false);
+	const uint64 TraceStart = FPlatformTime::Cycles64();
+	for (int32 Index = 0; Index < Samples.Num(); ++Index)
+	{
+		const bool bOnGround = World->LineTraceTestByChannel(Samples[Index], Samples[Index] - FVector::UpVector * CheckDistance, ECC_Visibility, QueryParams);
+		NumMismatches += CacheResults[Index] >= 0 && CacheResults[Index] != static_cast<int8>(bOnGround);
+	}
+	const double TraceUs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - TraceStart) * 1000.0 / Samples.Num();
+
+	UE_LOG(LogPracticeMovement, Display, TEXT("GroundCache : query %.3f us vs trace %.3f us (x%.1f), %d / %d answered by cache, %d mismatches"),
+		CacheUs, TraceUs, CacheUs > 0.0 ? TraceUs / CacheUs : 0.0, NumHits, Samples.Num(), NumMismatches);
+#endif
+}
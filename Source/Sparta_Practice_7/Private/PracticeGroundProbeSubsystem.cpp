@@ -0,0 +1,119 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PracticeGroundProbeSubsystem.h"
+
+#include "Engine/World.h"
+#include "PracticeMovementProfiler.h"
+#include "PracticeMovementStats.h"
+
+DEFINE_STAT(STAT_PracticeGroundProbeIssued);
+DEFINE_STAT(STAT_PracticeGroundProbeBatched);
+DEFINE_STAT(STAT_PracticeGroundProbeLate);
+DEFINE_STAT(STAT_PracticeGroundTraces);
+
+static TAutoConsoleVariable<int32> CVarPracticeGroundProbeAsync(
+	TEXT("practice.GroundProbe.Async"),
+	1,
+	TEXT("지면 검사를 비동기 Trace로 처리하고 결과를 다음 프레임에 사용한다.\n")
+	TEXT("0: 매번 동기 Trace, 1: 비동기 Trace"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarPracticeGroundProbeSyncFallback(
+	TEXT("practice.GroundProbe.SyncFallback"),
+	1,
+	TEXT("비동기 결과가 준비되지 않았을 때의 처리\n")
+	TEXT("0: 마지막 결과를 사용, 1: 동기 Trace"),
+	ECVF_Default);
+
+void UPracticeGroundProbeSubsystem::Deinitialize()
+{
+	Probes.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UPracticeGroundProbeSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UPracticeGroundProbeSubsystem::TraceSync(const UWorld* World, const AActor* Pawn, const FVector& Start, const FVector& End)
+{
+	FHitResult GroundHit;
+	return TraceSync(World, Pawn, Start, End, GroundHit);
+}
+
+bool UPracticeGroundProbeSubsystem::TraceSync(const UWorld* World, const AActor* Pawn, const FVector& Start, const FVector& End, FHitResult& OutHit)
+{
+	FCollisionQueryParams CollisionParams;
+	CollisionParams.AddIgnoredActor(Pawn);
+
+	PRACTICE_MOVEMENT_COUNT_TRACES(1);
+	INC_DWORD_STAT(STAT_PracticeGroundTraces);
+	return World->LineTraceSingleByChannel(OutHit, Start, End, ECC_Visibility, CollisionParams);
+}
+
+bool UPracticeGroundProbeSubsystem::Probe(const AActor* Pawn, const FVector& Start, const FVector& End)
+{
+	INC_DWORD_STAT(STAT_PracticeGroundProbeIssued);
+
+	UWorld* World = GetWorld();
+	if (!CVarPracticeGroundProbeAsync.GetValueOnGameThread())
+	{
+		return TraceSync(World, Pawn, Start, End);
+	}
+
+	FGroundProbe& GroundProbe = Probes.FindOrAdd(FObjectKey(Pawn));
+
+	// 1. 이전 프레임에 제출한 Probe 결과 확인
+	// Async Trace의 결과는 제출한 다음 프레임에만 유효하다.
+	bool bOnGround = false;
+	bool bHasResult = false;
+	FTraceDatum TraceDatum;
+	if (GroundProbe.Handle.IsValid()
+		&& GroundProbe.SubmitFrame + 1 == GFrameCounter
+		&& World->QueryTraceData(GroundProbe.Handle, TraceDatum))
+	{
+		bOnGround = TraceDatum.OutHits.ContainsByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+		bHasResult = true;
+	}
+	// 같은 프레임에 다시 요청한 경우에는 이미 구한 결과를 사용한다.
+	else if (GroundProbe.SubmitFrame == GFrameCounter && GroundProbe.bHasLastResult)
+	{
+		return GroundProbe.bLastResult;
+	}
+
+	// 2. 결과가 없으면 동기 Trace 혹은 마지막 결과
+	if (!bHasResult)
+	{
+		INC_DWORD_STAT(STAT_PracticeGroundProbeLate);
+		// 마지막 결과는 바로 이전 프레임의 결과일 때만 사용한다.
+		const bool bLastResultIsRecent = GroundProbe.bHasLastResult && GroundProbe.SubmitFrame + 1 == GFrameCounter;
+		if (CVarPracticeGroundProbeSyncFallback.GetValueOnGameThread() || !bLastResultIsRecent)
+		{
+			bOnGround = TraceSync(World, Pawn, Start, End);
+		}
+		else
+		{
+			bOnGround = GroundProbe.bLastResult;
+		}
+	}
+
+	// 3. 다음 프레임에서 사용할 Probe 제출
+	FCollisionQueryParams CollisionParams(SCENE_QUERY_STAT(PracticeGroundProbe), false, Pawn);
+	PRACTICE_MOVEMENT_COUNT_TRACES(1);
+	INC_DWORD_STAT(STAT_PracticeGroundTraces);
+	GroundProbe.Handle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End, ECC_Visibility, CollisionParams);
+	GroundProbe.SubmitFrame = GFrameCounter;
+	GroundProbe.bHasLastResult = true;
+	GroundProbe.bLastResult = bOnGround;
+	INC_DWORD_STAT(STAT_PracticeGroundProbeBatched);
+
+	return bOnGround;
+}
+
+void UPracticeGroundProbeSubsystem::Forget(const AActor* Pawn)
+{
+	Probes.Remove(FObjectKey(Pawn));
+}
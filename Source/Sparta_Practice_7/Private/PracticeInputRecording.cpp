@@ -0,0 +1,101 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PracticeInputRecording.h"
+
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	constexpr uint32 SnapshotMagic = 0x4E535250; // 'PRSN'
+
+	bool SaveBytes(const FString& FileName, const TArray<uint8>& Bytes)
+	{
+		const FString Path = FPracticeInputRecording::ResolvePath(FileName);
+		FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*FPaths::GetPath(Path));
+		return FFileHelper::SaveArrayToFile(Bytes, *Path);
+	}
+}
+
+FString FPracticeInputRecording::ResolvePath(const FString& FileName)
+{
+	if (FPaths::IsRelative(FileName))
+	{
+		return FPaths::ProjectSavedDir() / TEXT("InputRecordings") / FileName;
+	}
+	return FileName;
+}
+
+bool FPracticeInputRecording::Save(const FString& FileName) const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	uint32 FileMagic = Magic;
+	uint32 FileVersion = Version;
+	Writer << FileMagic << FileVersion;
+	Writer << const_cast<FPracticeMovementSnapshot&>(StartState);
+	Writer << const_cast<TArray<FPracticeInputFrame>&>(Frames);
+
+	return SaveBytes(FileName, Bytes);
+}
+
+bool FPracticeInputRecording::Load(const FString& FileName)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *ResolvePath(FileName)))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+	uint32 FileMagic = 0;
+	uint32 FileVersion = 0;
+	Reader << FileMagic << FileVersion;
+	if (FileMagic != Magic || FileVersion != Version)
+	{
+		return false;
+	}
+
+	Reader << StartState;
+	Reader << Frames;
+	return !Reader.IsError();
+}
+
+bool FPracticeInputRecording::SaveSnapshot(const FString& FileName, const FPracticeMovementSnapshot& Snapshot)
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	uint32 FileMagic = SnapshotMagic;
+	uint32 FileVersion = Version;
+	Writer << FileMagic << FileVersion;
+	Writer << const_cast<FPracticeMovementSnapshot&>(Snapshot);
+
+	return SaveBytes(FileName, Bytes);
+}
+
+bool FPracticeInputRecording::LoadSnapshot(const FString& FileName, FPracticeMovementSnapshot& OutSnapshot)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *ResolvePath(FileName)))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+	uint32 FileMagic = 0;
+	uint32 FileVersion = 0;
+	Reader << FileMagic << FileVersion;
+	if (FileMagic != SnapshotMagic || FileVersion != Version)
+	{
+		return false;
+	}
+
+	Reader << OutSnapshot;
+	return !Reader.IsError();
+}
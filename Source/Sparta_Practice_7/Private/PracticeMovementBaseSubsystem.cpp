@@ -0,0 +1,188 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PracticeMovementBaseSubsystem.h"
+
+#include "Components/SceneComponent.h"
+#include "PracticeCharacter.h"
+#include "PracticeMovementStats.h"
+
+DEFINE_STAT(STAT_PracticeBaseMovement);
+DEFINE_STAT(STAT_PracticeMovementBases);
+DEFINE_STAT(STAT_PracticeBasedPawns);
+DEFINE_STAT(STAT_PracticeBasedPawnMoves);
+
+void UPracticeMovementBaseSubsystem::Deinitialize()
+{
+	while (!Groups.IsEmpty())
+	{
+		FBaseGroup& Group = Groups.Last();
+		for (const TWeakObjectPtr<APracticeCharacter>& Rider : Group.Riders)
+		{
+			if (APracticeCharacter* Pawn = Rider.Get())
+			{
+				Pawn->MovementBaseIndex = INDEX_NONE;
+			}
+		}
+		DEC_DWORD_STAT_BY(STAT_PracticeBasedPawns, Group.Riders.Num());
+		RemoveGroup(Groups.Num() - 1);
+	}
+
+	Super::Deinitialize();
+}
+
+bool UPracticeMovementBaseSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UPracticeMovementBaseSubsystem::SetBase(APracticeCharacter* Pawn, USceneComponent* NewBase)
+{
+	const int32 OldIndex = Pawn->MovementBaseIndex;
+	if (OldIndex != INDEX_NONE)
+	{
+		if (Groups[OldIndex].Base.Get() == NewBase)
+		{
+			return;
+		}
+		RemoveRider(OldIndex, Pawn);
+	}
+
+	if (!NewBase)
+	{
+		return;
+	}
+
+	int32 NewIndex = INDEX_NONE;
+	if (const int32* FoundIndex = GroupIndices.Find(FObjectKey(NewBase)))
+	{
+		NewIndex = *FoundIndex;
+	}
+	else
+	{
+		NewIndex = Groups.AddDefaulted();
+		FBaseGroup& Group = Groups[NewIndex];
+		Group.Base = NewBase;
+		Group.BaseKey = FObjectKey(NewBase);
+		Group.LastTransform = NewBase->GetComponentTransform();
+		Group.MovedHandle = NewBase->TransformUpdated.AddUObject(this, &UPracticeMovementBaseSubsystem::OnBaseMoved);
+		if (UPrimitiveComponent* BasePrimitive = Cast<UPrimitiveComponent>(NewBase))
+		{
+			BasePrimitive->OnComponentPhysicsStateChanged.AddDynamic(this, &UPracticeMovementBaseSubsystem::OnBasePhysicsStateChanged);
+		}
+		GroupIndices.Add(Group.BaseKey, NewIndex);
+		INC_DWORD_STAT(STAT_PracticeMovementBases);
+	}
+
+	Groups[NewIndex].Riders.Add(Pawn);
+	Pawn->MovementBaseIndex = NewIndex;
+	INC_DWORD_STAT(STAT_PracticeBasedPawns);
+}
+
+void UPracticeMovementBaseSubsystem::RemoveRider(int32 GroupIndex, APracticeCharacter* Pawn)
+{
+	FBaseGroup& Group = Groups[GroupIndex];
+	Group.Riders.RemoveSingleSwap(Pawn, EAllowShrinking::No);
+	Pawn->MovementBaseIndex = INDEX_NONE;
+	DEC_DWORD_STAT(STAT_PracticeBasedPawns);
+
+	if (Group.Riders.IsEmpty())
+	{
+		RemoveGroup(GroupIndex);
+	}
+}
+
+void UPracticeMovementBaseSubsystem::RemoveGroup(int32 GroupIndex)
+{
+	FBaseGroup& Group = Groups[GroupIndex];
+	if (USceneComponent* Base = Group.Base.Get())
+	{
+		Base->TransformUpdated.Remove(Group.MovedHandle);
+		if (UPrimitiveComponent* BasePrimitive = Cast<UPrimitiveComponent>(Base))
+		{
+			BasePrimitive->OnComponentPhysicsStateChanged.RemoveDynamic(this, &UPracticeMovementBaseSubsystem::OnBasePhysicsStateChanged);
+		}
+	}
+	GroupIndices.Remove(Group.BaseKey);
+	DEC_DWORD_STAT(STAT_PracticeMovementBases);
+
+	// 마지막 Group이 빈 자리로 옮겨 오므로 Index를 고친다.
+	Groups.RemoveAtSwap(GroupIndex, 1, EAllowShrinking::No);
+	if (Groups.IsValidIndex(GroupIndex))
+	{
+		FBaseGroup& MovedGroup = Groups[GroupIndex];
+		GroupIndices[MovedGroup.BaseKey] = GroupIndex;
+		for (const TWeakObjectPtr<APracticeCharacter>& Rider : MovedGroup.Riders)
+		{
+			if (APracticeCharacter* Pawn = Rider.Get())
+			{
+				Pawn->MovementBaseIndex = GroupIndex;
+			}
+		}
+	}
+}
+
+void UPracticeMovementBaseSubsystem::OnBaseMoved(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	const int32* GroupIndex = GroupIndices.Find(FObjectKey(UpdatedComponent));
+	if (!GroupIndex)
+	{
+		return;
+	}
+
+	FBaseGroup& Group = Groups[*GroupIndex];
+	const FTransform NewTransform = UpdatedComponent->GetComponentTransform();
+	if (NewTransform.Equals(Group.LastTransform, 0.0f))
+	{
+		return;
+	}
+
+	PRACTICE_MOVEMENT_STAT_SCOPE(BaseMovement);
+
+	// 이동량은 Base마다 한 번만 구하고 같은 Base의 Pawn을 차례로 옮긴다.
+	// Base는 Pawn의 Sweep 이동에서만 바뀌므로 옮기는 중에 Group은 바뀌지 않는다.
+	const FTransform OldTransform = Group.LastTransform;
+	Group.LastTransform = NewTransform;
+	const FQuat DeltaRotation = NewTransform.GetRotation() * OldTransform.GetRotation().Inverse();
+	const float DeltaYaw = DeltaRotation.Rotator().Yaw;
+
+	// Pawn은 UPrimitiveComponent만 Base로 기록한다.
+	UPrimitiveComponent* Base = CastChecked<UPrimitiveComponent>(UpdatedComponent);
+	const int32 NumRiders = Group.Riders.Num();
+	for (int32 Index = 0; Index < NumRiders; ++Index)
+	{
+		if (APracticeCharacter* Pawn = Groups[*GroupIndex].Riders[Index].Get())
+		{
+			Pawn->ApplyBaseMovement(Base, OldTransform, NewTransform, DeltaYaw);
+		}
+	}
+	INC_DWORD_STAT_BY(STAT_PracticeBasedPawnMoves, NumRiders);
+}
+
+void UPracticeMovementBaseSubsystem::OnBasePhysicsStateChanged(UPrimitiveComponent* ChangedComponent, EComponentPhysicsStateChange StateChange)
+{
+	if (StateChange != EComponentPhysicsStateChange::Destroyed)
+	{
+		return;
+	}
+
+	const int32* GroupIndex = GroupIndices.Find(FObjectKey(ChangedComponent));
+	if (!GroupIndex)
+	{
+		return;
+	}
+
+	// Base가 없어지면 위의 Pawn은 설 곳이 없다. Sleep 중인 Pawn도 깨워서 다음 이동에서 지면을 다시 판단한다.
+	const TArray<TWeakObjectPtr<APracticeCharacter>> Riders = MoveTemp(Groups[*GroupIndex].Riders);
+	DEC_DWORD_STAT_BY(STAT_PracticeBasedPawns, Riders.Num());
+	RemoveGroup(*GroupIndex);
+
+	for (const TWeakObjectPtr<APracticeCharacter>& Rider : Riders)
+	{
+		if (APracticeCharacter* Pawn = Rider.Get())
+		{
+			Pawn->MovementBaseIndex = INDEX_NONE;
+			Pawn->WakeUp();
+		}
+	}
+}
@@ -0,0 +1,482 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PracticeMovementBenchmark.h"
+
+#include "AIController.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/PlayerStart.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "PracticeCharacter.h"
+#include "PracticeMovingPlatform.h"
+#include "Sparta_Practice_7.h"
+
+bool UPracticeMovementBenchmark::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if PRACTICE_MOVEMENT_PROFILER
+	return FParse::Param(FCommandLine::Get(), TEXT("PracticeBench")) && Super::ShouldCreateSubsystem(Outer);
+#else
+	return false;
+#endif
+}
+
+bool UPracticeMovementBenchmark::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UPracticeMovementBenchmark::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+
+	FString CountsString = TEXT("1,100,1000,10000");
+	FParse::Value(CommandLine, TEXT("PracticeBenchCounts="), CountsString, false);
+	TArray<FString> CountStrings;
+	CountsString.ParseIntoArray(CountStrings, TEXT(","));
+	for (const FString& CountString : CountStrings)
+	{
+		const int32 Count = FCString::Atoi(*CountString);
+		if (Count > 0)
+		{
+			PawnCounts.Add(Count);
+		}
+	}
+
+	FParse::Value(CommandLine, TEXT("PracticeBenchFrames="), NumMeasureFrames);
+	FParse::Value(CommandLine, TEXT("PracticeBenchWarmup="), NumWarmupFrames);
+	NumMeasureFrames = FMath::Max(NumMeasureFrames, 1);
+	NumWarmupFrames = FMath::Max(NumWarmupFrames, 0);
+	bUseBatchedMovement = FParse::Param(CommandLine, TEXT("PracticeBenchBatched"));
+	bUseCameraRigs = FParse::Param(CommandLine, TEXT("PracticeBenchCameraRigs"));
+	bUseLateCamera = FParse::Param(CommandLine, TEXT("PracticeBenchLateCamera"));
+	FParse::Value(CommandLine, TEXT("PracticeBenchIdle="), IdlePercent);
+	IdlePercent = FMath::Clamp(IdlePercent, 0, 100);
+	FParse::Value(CommandLine, TEXT("PracticeBenchPlatforms="), NumPlatforms);
+	NumPlatforms = FMath::Max(NumPlatforms, 0);
+	bExitWhenDone = !FParse::Param(CommandLine, TEXT("PracticeBenchNoExit"));
+
+	if (!FParse::Value(CommandLine, TEXT("PracticeBenchOut="), OutputPath))
+	{
+		OutputPath = FPaths::ProfilingDir() / TEXT("PracticeBench") / FDateTime::Now().ToString();
+	}
+
+	UE_LOG(LogPracticeMovement, Display, TEXT("PracticeBench : %d runs, %d warmup / %d measure frames, batched %d, camera rigs %d, late camera %d, idle %d%%, platforms %d"),
+		PawnCounts.Num(), NumWarmupFrames, NumMeasureFrames, bUseBatchedMovement, bUseCameraRigs, bUseLateCamera, IdlePercent, NumPlatforms);
+
+	if (PawnCounts.IsEmpty())
+	{
+		Finish();
+		return;
+	}
+
+#if PRACTICE_MOVEMENT_PROFILER
+	FPracticeMovementProfiler::SetEnabled(true);
+#endif
+	StartRun(0);
+}
+
+void UPracticeMovementBenchmark::Deinitialize()
+{
+#if PRACTICE_MOVEMENT_PROFILER
+	FPracticeMovementProfiler::SetEnabled(false);
+#endif
+	Pawns.Reset();
+	Platforms.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId UPracticeMovementBenchmark::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPracticeMovementBenchmark, STATGROUP_Tickables);
+}
+
+bool UPracticeMovementBenchmark::IsTickable() const
+{
+	return Phase == EPhase::Warmup || Phase == EPhase::Measure;
+}
+
+void UPracticeMovementBenchmark::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// 이동이 모두 끝난 뒤이므로 Camera Manager의 갱신 시점과 같다.
+	if (bUseLateCamera && (Phase == EPhase::Warmup || Phase == EPhase::Measure))
+	{
+		UpdateLateCameras(DeltaTime);
+	}
+
+	// 이번 프레임의 이동 처리는 이미 끝났으므로 결과를 기록하고 다음 프레임의 입력을 넣는다.
+	switch (Phase)
+	{
+	case EPhase::Warmup:
+		if (++FrameInPhase >= NumWarmupFrames)
+		{
+			// Warmup 동안의 기록은 버린다.
+#if PRACTICE_MOVEMENT_PROFILER
+			FPracticeMovementProfiler::ConsumeFrame();
+#endif
+			Phase = EPhase::Measure;
+			FrameInPhase = 0;
+			LastFrameTime = FPlatformTime::Seconds();
+		}
+		break;
+	case EPhase::Measure:
+		RecordFrame(DeltaTime);
+		if (++FrameInPhase >= NumMeasureFrames)
+		{
+			EndRun();
+			return;
+		}
+		break;
+	default:
+		return;
+	}
+
+	DriveInput();
+}
+
+void UPracticeMovementBenchmark::StartRun(int32 RunIndex)
+{
+	CurrentRun = RunIndex;
+	for (TArray<double>& MetricSamples : Samples)
+	{
+		MetricSamples.Reset(NumMeasureFrames);
+	}
+
+	SpawnPawns(PawnCounts[RunIndex]);
+	SpawnPlatforms();
+	DriveInput();
+
+	Phase = EPhase::Warmup;
+	FrameInPhase = 0;
+	if (NumWarmupFrames == 0)
+	{
+		Phase = EPhase::Measure;
+		LastFrameTime = FPlatformTime::Seconds();
+	}
+}
+
+void UPracticeMovementBenchmark::EndRun()
+{
+	FResult& Result = Results.AddDefaulted_GetRef();
+	Result.NumPawns = PawnCounts[CurrentRun];
+
+	for (int32 Metric = 0; Metric < NumMetrics; ++Metric)
+	{
+		TArray<double>& MetricSamples = Samples[Metric];
+		if (MetricSamples.IsEmpty())
+		{
+			continue;
+		}
+
+		double Sum = 0.0;
+		for (const double Value : MetricSamples)
+		{
+			Sum += Value;
+		}
+		MetricSamples.Sort();
+
+		const int32 NumSamples = MetricSamples.Num();
+		const auto Percentile = [&MetricSamples, NumSamples](double Fraction)
+		{
+			const int32 Index = FMath::Clamp(FMath::CeilToInt32(Fraction * NumSamples) - 1, 0, NumSamples - 1);
+			return MetricSamples[Index];
+		};
+		Result.Mean[Metric] = Sum / NumSamples;
+		Result.P50[Metric] = Percentile(0.5);
+		Result.P99[Metric] = Percentile(0.99);
+	}
+
+	UE_LOG(LogPracticeMovement, Display, TEXT("PracticeBench : %d pawns, frame mean %.3f ms, p99 %.3f ms"),
+		Result.NumPawns, Result.Mean[FrameMetric], Result.P99[FrameMetric]);
+
+	DestroyPawns();
+	DestroyPlatforms();
+
+	if (CurrentRun + 1 < PawnCounts.Num())
+	{
+		StartRun(CurrentRun + 1);
+	}
+	else
+	{
+		Finish();
+	}
+}
+
+void UPracticeMovementBenchmark::SpawnPawns(int32 Count)
+{
+	UWorld* World = GetWorld();
+
+	TSubclassOf<APracticeCharacter> PawnClass = APracticeCharacter::StaticClass();
+	if (const AGameModeBase* GameMode = World->GetAuthGameMode())
+	{
+		if (GameMode->DefaultPawnClass && GameMode->DefaultPawnClass->IsChildOf(APracticeCharacter::StaticClass()))
+		{
+			PawnClass = GameMode->DefaultPawnClass.Get();
+		}
+	}
+
+	// PlayerStart 주변에 격자로 배치한다.
+	FVector Origin = FVector(0.0f, 0.0f, 200.0f);
+	for (TActorIterator<APlayerStart> It(World); It; ++It)
+	{
+		Origin = It->GetActorLocation();
+		break;
+	}
+
+	// 발판을 사용하면 지면과 겹치지 않도록 위에서 시작한다.
+	if (NumPlatforms > 0)
+	{
+		Origin.Z += PlatformLift;
+	}
+
+	const int32 GridSize = FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(Count)));
+	PawnGridOrigin = Origin;
+	PawnGridSize = GridSize;
+	Pawns.Reserve(Count);
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		const FVector Offset((Index % GridSize - GridSize / 2) * PawnSpacing, (Index / GridSize - GridSize / 2) * PawnSpacing, 0.0f);
+		const FTransform SpawnTransform(FRotator::ZeroRotator, Origin + Offset);
+
+		APracticeCharacter* Pawn = World->SpawnActorDeferred<APracticeCharacter>(
+			PawnClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		if (!Pawn)
+		{
+			continue;
+		}
+		Pawn->bUseBatchedMovement = bUseBatchedMovement;
+		Pawn->bAlwaysUseCameraRig = bUseCameraRigs;
+		Pawn->FinishSpawning(SpawnTransform);
+		// 이동 처리에 Controller의 회전을 사용하므로 Controller가 필요하다.
+		// AIControllerClass(APracticeAIController)는 AI 부하 테스트용이므로 이전 결과와 비교할 수 있도록 기본 AIController를 사용한다.
+		if (AAIController* Controller = World->SpawnActor<AAIController>())
+		{
+			Controller->Possess(Pawn);
+		}
+		// Controller가 바뀌면 늦은 갱신이 꺼지므로 Controller를 만든 뒤에 켠다.
+		Pawn->SetLateCameraUpdate(bUseLateCamera);
+		Pawns.Add(Pawn);
+	}
+}
+
+void UPracticeMovementBenchmark::DestroyPawns()
+{
+	for (APracticeCharacter* Pawn : Pawns)
+	{
+		if (!IsValid(Pawn))
+		{
+			continue;
+		}
+		if (AController* Controller = Pawn->GetController())
+		{
+			Controller->Destroy();
+		}
+		Pawn->Destroy();
+	}
+	Pawns.Reset();
+}
+
+void UPracticeMovementBenchmark::SpawnPlatforms()
+{
+	if (NumPlatforms <= 0 || Pawns.IsEmpty() || PawnGridSize <= 0)
+	{
+		return;
+	}
+
+	// Pawn 격자 전체를 PlatformGridSize x PlatformGridSize 칸으로 나누고, 발판 윗면을 Pawn 발 바로 아래에 둔다.
+	const int32 PlatformGridSize = FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(NumPlatforms)));
+	const float GridExtent = PawnGridSize * PawnSpacing;
+	const float CellSize = GridExtent / PlatformGridSize;
+	const float GridMin = -(PawnGridSize / 2) * PawnSpacing - PawnSpacing * 0.5f;
+	constexpr float Thickness = 20.0f;
+	const float TopZ = PawnGridOrigin.Z - Pawns[0]->GetSimpleCollisionHalfHeight() - 5.0f;
+
+	UWorld* World = GetWorld();
+	Platforms.Reserve(NumPlatforms);
+	for (int32 Index = 0; Index < NumPlatforms; ++Index)
+	{
+		const FVector Location(
+			PawnGridOrigin.X + GridMin + (Index % PlatformGridSize + 0.5f) * CellSize,
+			PawnGridOrigin.Y + GridMin + (Index / PlatformGridSize + 0.5f) * CellSize,
+			TopZ - Thickness * 0.5f);
+		const FTransform SpawnTransform(FRotator::ZeroRotator, Location);
+
+		APracticeMovingPlatform* Platform = World->SpawnActorDeferred<APracticeMovingPlatform>(
+			APracticeMovingPlatform::StaticClass(), SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		if (!Platform)
+		{
+			continue;
+		}
+		// 이웃한 발판과 겹치지 않도록 위아래로만 움직이고, 발판마다 위상을 다르게 한다.
+		Platform->Travel = FVector(0.0f, 0.0f, 200.0f);
+		Platform->Period = 4.0f;
+		Platform->PhaseOffset = static_cast<float>(Index) / NumPlatforms;
+		Platform->SetActorScale3D(FVector(CellSize / 100.0f, CellSize / 100.0f, Thickness / 100.0f));
+		Platform->FinishSpawning(SpawnTransform);
+		Platforms.Add(Platform);
+	}
+}
+
+void UPracticeMovementBenchmark::DestroyPlatforms()
+{
+	for (APracticeMovingPlatform* Platform : Platforms)
+	{
+		if (IsValid(Platform))
+		{
+			Platform->Destroy();
+		}
+	}
+	Platforms.Reset();
+}
+
+void UPracticeMovementBenchmark::DriveInput()
+{
+	// 같은 인자로 실행하면 같은 입력이 들어가도록 프레임과 Index로만 결정한다.
+	const int32 Frame = FrameInPhase + (Phase == EPhase::Measure ? NumWarmupFrames : 0);
+	for (int32 Index = 0; Index < Pawns.Num(); ++Index)
+	{
+		APracticeCharacter* Pawn = Pawns[Index];
+		if (!IsValid(Pawn) || IsIdlePawn(Index))
+		{
+			continue;
+		}
+
+		const float Angle = FMath::DegreesToRadians(static_cast<float>((Index * 37 + Frame * 2) % 360));
+		Pawn->SetMoveInput(FVector2D(FMath::Cos(Angle), FMath::Sin(Angle)));
+		// 마우스 입력처럼 프레임 사이의 이동량을 넣는다.
+		Pawn->AddLookInput(FVector2D(FMath::Sin(Angle), 0.2f * FMath::Cos(Angle)));
+		if ((Frame + Index) % 90 == 0)
+		{
+			Pawn->RequestJump();
+		}
+	}
+}
+
+void UPracticeMovementBenchmark::UpdateLateCameras(float DeltaTime)
+{
+	for (APracticeCharacter* Pawn : Pawns)
+	{
+		if (IsValid(Pawn))
+		{
+			Pawn->UpdateCameraLate(DeltaTime);
+		}
+	}
+}
+
+void UPracticeMovementBenchmark::RecordFrame(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	Samples[FrameMetric].Add((Now - LastFrameTime) * 1000.0);
+	LastFrameTime = Now;
+
+#if PRACTICE_MOVEMENT_PROFILER
+	const FPracticeMovementProfiler::FFrame Frame = FPracticeMovementProfiler::ConsumeFrame();
+	for (int32 Section = 0; Section < NumSections; ++Section)
+	{
+		Samples[Section].Add(FPlatformTime::ToMilliseconds64(Frame.Cycles[Section]));
+	}
+	Samples[SweepMetric].Add(Frame.Sweeps);
+	Samples[TraceMetric].Add(Frame.Traces);
+	if (Frame.LookSamples > 0)
+	{
+		Samples[LookLatencyMetric].Add(FPlatformTime::ToMilliseconds64(Frame.LookLatencyCycles));
+	}
+#endif
+
+	int32 NumSleeping = 0;
+	int32 NumBased = 0;
+	for (const APracticeCharacter* Pawn : Pawns)
+	{
+		if (IsValid(Pawn))
+		{
+			NumSleeping += Pawn->IsSleeping();
+			NumBased += Pawn->GetMovementBase() != nullptr;
+		}
+	}
+	Samples[SleepingMetric].Add(NumSleeping);
+	Samples[BasedMetric].Add(NumBased);
+}
+
+FString UPracticeMovementBenchmark::GetMetricName(int32 Metric)
+{
+	switch (Metric)
+	{
+	case FrameMetric:	return TEXT("FrameMs");
+	case SweepMetric:	return TEXT("Sweeps");
+	case TraceMetric:	return TEXT("Traces");
+	case LookLatencyMetric:	return TEXT("LookLatencyMs");
+	case SleepingMetric:	return TEXT("SleepingPawns");
+	case BasedMetric:	return TEXT("BasedPawns");
+	default:
+		break;
+	}
+#if PRACTICE_MOVEMENT_PROFILER
+	return FString(FPracticeMovementProfiler::GetSectionName(static_cast<EPracticeMovementSection>(Metric))) + TEXT("Ms");
+#else
+	return FString();
+#endif
+}
+
+void UPracticeMovementBenchmark::WriteResults() const
+{
+	// CSV : 한 줄에 (Pawn 수, 항목) 하나
+	FString Csv = TEXT("NumPawns,Batched,CameraRigs,LateCamera,IdlePercent,Platforms,Metric,Mean,P50,P99\n");
+	for (const FResult& Result : Results)
+	{
+		for (int32 Metric = 0; Metric < NumMetrics; ++Metric)
+		{
+			Csv += FString::Printf(TEXT("%d,%d,%d,%d,%d,%d,%s,%.4f,%.4f,%.4f\n"),
+				Result.NumPawns, bUseBatchedMovement, bUseCameraRigs, bUseLateCamera, IdlePercent, NumPlatforms, *GetMetricName(Metric), Result.Mean[Metric], Result.P50[Metric], Result.P99[Metric]);
+		}
+	}
+
+	// JSON : 실행 하나에 항목별 통계
+	FString Json = FString::Printf(TEXT("{\n\t\"batched\": %s,\n\t\"cameraRigs\": %s,\n\t\"lateCamera\": %s,\n\t\"idlePercent\": %d,\n\t\"platforms\": %d,\n\t\"warmupFrames\": %d,\n\t\"measureFrames\": %d,\n\t\"runs\": [\n"),
+		bUseBatchedMovement ? TEXT("true") : TEXT("false"), bUseCameraRigs ? TEXT("true") : TEXT("false"), bUseLateCamera ? TEXT("true") : TEXT("false"),
+		IdlePercent, NumPlatforms, NumWarmupFrames, NumMeasureFrames);
+	for (int32 RunIndex = 0; RunIndex < Results.Num(); ++RunIndex)
+	{
+		const FResult& Result = Results[RunIndex];
+		Json += FString::Printf(TEXT("\t\t{\n\t\t\t\"numPawns\": %d,\n\t\t\t\"metrics\": {\n"), Result.NumPawns);
+		for (int32 Metric = 0; Metric < NumMetrics; ++Metric)
+		{
+			Json += FString::Printf(TEXT("\t\t\t\t\"%s\": { \"mean\": %.4f, \"p50\": %.4f, \"p99\": %.4f }%s\n"),
+				*GetMetricName(Metric), Result.Mean[Metric], Result.P50[Metric], Result.P99[Metric],
+				Metric + 1 < NumMetrics ? TEXT(",") : TEXT(""));
+		}
+		Json += FString::Printf(TEXT("\t\t\t}\n\t\t}%s\n"), RunIndex + 1 < Results.Num() ? TEXT(",") : TEXT(""));
+	}
+	Json += TEXT("\t]\n}\n");
+
+	const FString CsvPath = OutputPath + TEXT(".csv");
+	const FString JsonPath = OutputPath + TEXT(".json");
+	FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*FPaths::GetPath(CsvPath));
+	FFileHelper::SaveStringToFile(Csv, *CsvPath);
+	FFileHelper::SaveStringToFile(Json, *JsonPath);
+
+	UE_LOG(LogPracticeMovement, Display, TEXT("PracticeBench : results written to %s(.csv / .json)"), *OutputPath);
+}
+
+void UPracticeMovementBenchmark::Finish()
+{
+	Phase = EPhase::Done;
+#if PRACTICE_MOVEMENT_PROFILER
+	FPracticeMovementProfiler::SetEnabled(false);
+#endif
+
+	WriteResults();
+
+	if (bExitWhenDone)
+	{
+		FPlatformMisc::RequestExit(false, TEXT("PracticeBench"));
+	}
+}
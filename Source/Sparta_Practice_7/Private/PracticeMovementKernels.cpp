@@ -0,0 +1,158 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PracticeMovementKernels.h"
+
+#include "Math/VectorRegister.h"
+
+void FPracticeMovementParamLanes::Add(const FPracticeMovementParams& Params)
+{
+	MoveSpeed.Add(Params.MoveSpeed);
+	AccelDamp.Add(Params.AccelDamp);
+	Gravity.Add(Params.Gravity);
+	FallMultiplier.Add(Params.FallMultiplier);
+	TerminalSpeed.Add(Params.TerminalSpeed);
+}
+
+void FPracticeMovementParamLanes::RemoveAtSwap(int32 Index)
+{
+	MoveSpeed.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	AccelDamp.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Gravity.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	FallMultiplier.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	TerminalSpeed.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void FPracticeMovementParamLanes::Reset()
+{
+	MoveSpeed.Reset();
+	AccelDamp.Reset();
+	Gravity.Reset();
+	FallMultiplier.Reset();
+	TerminalSpeed.Reset();
+}
+
+namespace PracticeMovementKernels
+{
+	// Lane 배열의 값이 0보다 크면 모든 비트가 1인 Mask
+	FORCEINLINE VectorRegister4Float LoadLaneMask(const float* Lane)
+	{
+		return VectorCompareGT(VectorLoad(Lane), VectorZeroFloat());
+	}
+
+	void CalculateVelocity(float* RESTRICT Velocity, const float* RESTRICT TargetVelocity, const float* RESTRICT AccelDamp,
+		const float* RESTRICT DeltaTime, const float* RESTRICT GroundLane, int32 Num)
+	{
+		const VectorRegister4Float Zero = VectorZeroFloat();
+		const VectorRegister4Float One = VectorOneFloat();
+		const VectorRegister4Float NearlyEqualTolerance = VectorSetFloat1(UE_SMALL_NUMBER);
+
+		int32 Index = 0;
+		for (; Index + LaneWidth <= Num; Index += LaneWidth)
+		{
+			const VectorRegister4Float Current = VectorLoad(Velocity + Index);
+			const VectorRegister4Float Target = VectorLoad(TargetVelocity + Index);
+			const VectorRegister4Float Diff = VectorSubtract(Target, Current);
+
+			// Alpha = Clamp(DeltaTime * AccelDamp, 0, 1)
+			const VectorRegister4Float Alpha = VectorMin(VectorMax(VectorMultiply(VectorLoad(DeltaTime + Index), VectorLoad(AccelDamp + Index)), Zero), One);
+			const VectorRegister4Float Lerped = VectorMultiplyAdd(Diff, Alpha, Current);
+
+			// FMath::IsNearlyEqual이면 목표 속도를 그대로 사용한다.
+			const VectorRegister4Float NearlyEqual = VectorCompareGE(NearlyEqualTolerance, VectorAbs(Diff));
+			const VectorRegister4Float Result = VectorSelect(NearlyEqual, Target, Lerped);
+
+			VectorStore(VectorSelect(LoadLaneMask(GroundLane + Index), Result, Current), Velocity + Index);
+		}
+
+		for (; Index < Num; ++Index)
+		{
+			if (GroundLane[Index] > 0.f)
+			{
+				Velocity[Index] = PracticeMovement::CalculateVelocity(Velocity[Index], TargetVelocity[Index], AccelDamp[Index], DeltaTime[Index]);
+			}
+		}
+	}
+
+	void UpdateFallSpeed(float* RESTRICT FallSpeed, const float* RESTRICT Gravity, const float* RESTRICT FallMultiplier,
+		const float* RESTRICT TerminalSpeed, const float* RESTRICT DeltaTime, const float* RESTRICT GroundLane, const float* RESTRICT AirLane, int32 Num)
+	{
+		const VectorRegister4Float Zero = VectorZeroFloat();
+
+		int32 Index = 0;
+		for (; Index + LaneWidth <= Num; Index += LaneWidth)
+		{
+			const VectorRegister4Float GroundMask = LoadLaneMask(GroundLane + Index);
+			const VectorRegister4Float ActiveMask = VectorBitwiseOr(GroundMask, LoadLaneMask(AirLane + Index));
+
+			const VectorRegister4Float Previous = VectorLoad(FallSpeed + Index);
+			const VectorRegister4Float Current = VectorSelect(GroundMask, Zero, Previous);
+			const VectorRegister4Float Terminal = VectorLoad(TerminalSpeed + Index);
+			const VectorRegister4Float GravityStep = VectorMultiply(VectorLoad(Gravity + Index), VectorLoad(DeltaTime + Index));
+
+			// 상승 중 : 중력만 적용
+			const VectorRegister4Float Rising = VectorAdd(Current, GravityStep);
+			// 하강 중 : 중력 배수를 적용하고 종단 속도에서 멈춘다.
+			const VectorRegister4Float Falling = VectorMax(VectorMultiplyAdd(GravityStep, VectorLoad(FallMultiplier + Index), Current), Terminal);
+
+			// 종단 속도 이하면 그대로 둔다.
+			VectorRegister4Float Result = VectorSelect(VectorCompareGT(Current, Terminal), Falling, Current);
+			Result = VectorSelect(VectorCompareGE(Current, Zero), Rising, Result);
+
+			VectorStore(VectorSelect(ActiveMask, Result, Previous), FallSpeed + Index);
+		}
+
+		for (; Index < Num; ++Index)
+		{
+			if (GroundLane[Index] > 0.f || AirLane[Index] > 0.f)
+			{
+				const float Current = GroundLane[Index] > 0.f ? 0.f : FallSpeed[Index];
+				FallSpeed[Index] = PracticeMovement::UpdateFallSpeed(Current, Gravity[Index], FallMultiplier[Index], TerminalSpeed[Index], DeltaTime[Index]);
+			}
+		}
+	}
+
+	void ClampAirSpeed(float* RESTRICT Velocity, float* RESTRICT SpeedX, float* RESTRICT SpeedY, float* RESTRICT SpeedZ,
+		const float* RESTRICT MaxSpeed, const float* RESTRICT AirLane, int32 Num)
+	{
+		const VectorRegister4Float Zero = VectorZeroFloat();
+		const VectorRegister4Float One = VectorOneFloat();
+		const VectorRegister4Float NormalTolerance = VectorSetFloat1(UE_SMALL_NUMBER);
+
+		int32 Index = 0;
+		for (; Index + LaneWidth <= Num; Index += LaneWidth)
+		{
+			const VectorRegister4Float AirMask = LoadLaneMask(AirLane + Index);
+			const VectorRegister4Float X = VectorLoad(SpeedX + Index);
+			const VectorRegister4Float Y = VectorLoad(SpeedY + Index);
+			const VectorRegister4Float Z = VectorLoad(SpeedZ + Index);
+
+			const VectorRegister4Float SizeSquared = VectorMultiplyAdd(X, X, VectorMultiplyAdd(Y, Y, VectorMultiply(Z, Z)));
+			const VectorRegister4Float Size = VectorSqrt(SizeSquared);
+
+			// FVector::GetSafeNormal과 같이 너무 작으면 방향은 0이다.
+			const VectorRegister4Float ValidMask = VectorCompareGE(SizeSquared, NormalTolerance);
+			const VectorRegister4Float InvSize = VectorSelect(ValidMask, VectorDivide(One, Size), Zero);
+
+			// 최대 속도를 넘으면 방향은 그대로 두고 크기만 줄인다.
+			const VectorRegister4Float NewVelocity = VectorMin(Size, VectorLoad(MaxSpeed + Index));
+
+			VectorStore(VectorSelect(AirMask, NewVelocity, VectorLoad(Velocity + Index)), Velocity + Index);
+			VectorStore(VectorSelect(AirMask, VectorMultiply(X, InvSize), X), SpeedX + Index);
+			VectorStore(VectorSelect(AirMask, VectorMultiply(Y, InvSize), Y), SpeedY + Index);
+			VectorStore(VectorSelect(AirMask, VectorMultiply(Z, InvSize), Z), SpeedZ + Index);
+		}
+
+		for (; Index < Num; ++Index)
+		{
+			if (AirLane[Index] > 0.f)
+			{
+				FVector Direction;
+				PracticeMovement::ClampAirSpeed(FVector(SpeedX[Index], SpeedY[Index], SpeedZ[Index]), MaxSpeed[Index], Velocity[Index], Direction);
+				SpeedX[Index] = Direction.X;
+				SpeedY[Index] = Direction.Y;
+				SpeedZ[Index] = Direction.Z;
+			}
+		}
+	}
+}
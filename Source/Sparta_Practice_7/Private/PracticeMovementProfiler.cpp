@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PracticeMovementProfiler.h"
+
+#if PRACTICE_MOVEMENT_PROFILER
+
+bool FPracticeMovementProfiler::bEnabled = false;
+FPracticeMovementProfiler::FFrame FPracticeMovementProfiler::CurrentFrame;
+
+const TCHAR* FPracticeMovementProfiler::GetSectionName(EPracticeMovementSection Section)
+{
+	switch (Section)
+	{
+	case EPracticeMovementSection::Tick:			return TEXT("Tick");
+	case EPracticeMovementSection::PlaneMove:		return TEXT("PlaneMove");
+	case EPracticeMovementSection::AirPlaneMove:	return TEXT("AirPlaneMove");
+	case EPracticeMovementSection::Move:			return TEXT("Move");
+	case EPracticeMovementSection::IsOnGround:		return TEXT("IsOnGround");
+	case EPracticeMovementSection::UpdateCamera:	return TEXT("UpdateCamera");
+	case EPracticeMovementSection::BatchedPass:		return TEXT("BatchedPass");
+	default:										return TEXT("Unknown");
+	}
+}
+
+#endif
@@ -0,0 +1,683 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PracticeMovementSubsystem.h"
+
+#include "Async/ParallelFor.h"
+#include "PracticeCharacter.h"
+#include "PracticeMovementProfiler.h"
+#include "PracticeMovementStats.h"
+#include "Sparta_Practice_7.h"
+
+DEFINE_STAT(STAT_PracticeBatchedMovement);
+DEFINE_STAT(STAT_PracticeBatchedGather);
+DEFINE_STAT(STAT_PracticeBatchedIntegrate);
+DEFINE_STAT(STAT_PracticeBatchedCommit);
+DEFINE_STAT(STAT_PracticeBatchedPawns);
+DEFINE_STAT(STAT_PracticeBatchedMsPer1000);
+DEFINE_STAT(STAT_PracticeActorTickPawns);
+DEFINE_STAT(STAT_PracticeActorTickMsPer1000);
+
+static TAutoConsoleVariable<int32> CVarPracticeMovementParallelIntegrate(
+	TEXT("practice.Movement.ParallelIntegrate"),
+	1,
+	TEXT("배치 이동의 계산 단계를 Worker Thread에서 병렬로 처리한다.\n")
+	TEXT("0: Game Thread에서 순서대로 처리, 1: ParallelFor 사용"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarPracticeMovementParallelMinBatch(
+	TEXT("practice.Movement.ParallelMinBatch"),
+	64,
+	TEXT("ParallelFor 작업 하나가 처리하는 최소 Pawn 수"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarPracticeMovementSimdKernels(
+	TEXT("practice.Movement.SimdKernels"),
+	1,
+	TEXT("배치 이동의 속력, 낙하 속도, 공중 속도 제한을 SIMD로 4 Pawn씩 계산한다.\n")
+	TEXT("0: Pawn마다 Scalar 함수 사용, 1: PracticeMovementKernels 사용"),
+	ECVF_Default);
+
+#if !UE_BUILD_SHIPPING
+static TAutoConsoleVariable<int32> CVarPracticeMovementValidateKernels(
+	TEXT("practice.Movement.ValidateKernels"),
+	0,
+	TEXT("SIMD 계산 결과를 Scalar 함수 결과와 비교하고 허용 오차를 넘으면 경고를 출력한다."),
+	ECVF_Cheat);
+
+// SIMD 계산 결과의 상대 허용 오차. float 계산과 FVector(double) 계산의 차이를 허용한다.
+static constexpr float KernelTolerance = 1.e-4f;
+#endif
+
+void UPracticeMovementSubsystem::Deinitialize()
+{
+	for (APracticeCharacter* Pawn : Pawns)
+	{
+		if (Pawn)
+		{
+			Pawn->BatchedMovementIndex = INDEX_NONE;
+		}
+	}
+	Pawns.Reset();
+	InputDirection.Reset();
+	Velocity.Reset();
+	MoveDirection.Reset();
+	FallSpeed.Reset();
+	MovementMode.Reset();
+	StateTimeRemaining.Reset();
+	MovementTimers.Reset();
+	StateFlags.Reset();
+	Params.Reset();
+	ParamLanes.Reset();
+	Significance.Reset();
+	TickInterval.Reset();
+	AccumulatedTime.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UPracticeMovementSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UPracticeMovementSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPracticeMovementSubsystem, STATGROUP_Tickables);
+}
+
+int32 UPracticeMovementSubsystem::RegisterPawn(APracticeCharacter* Pawn)
+{
+	check(Pawn);
+	check(Pawn->BatchedMovementIndex == INDEX_NONE);
+
+	const int32 Index = Pawns.Add(Pawn);
+	InputDirection.Add(Pawn->InputDirection);
+	Velocity.Add(Pawn->Velocity);
+	MoveDirection.Add(Pawn->MoveDirection);
+	FallSpeed.Add(Pawn->FallSpeed);
+
+	MovementMode.Add(Pawn->MovementMode);
+	StateTimeRemaining.Add(Pawn->StateTimeRemaining);
+	MovementTimers.Add(Pawn->MovementTimers);
+	StateFlags.Add(EPracticeMovementFlags::None);
+	Params.Add(Pawn->GetMovementParams());
+	ParamLanes.Add(Params[Index]);
+	Significance.Add(Pawn->Significance);
+	TickInterval.Add(Pawn->GetActorTickInterval());
+	AccumulatedTime.Add(0.f);
+
+	return Index;
+}
+
+void UPracticeMovementSubsystem::UnregisterPawn(APracticeCharacter* Pawn)
+{
+	check(Pawn);
+	const int32 Index = Pawn->BatchedMovementIndex;
+	if (!Pawns.IsValidIndex(Index) || Pawns[Index] != Pawn)
+	{
+		return;
+	}
+
+	// 마지막 원소를 빈자리로 옮겨서 배열을 연속으로 유지한다.
+	Pawns.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	InputDirection.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Velocity.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	MoveDirection.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	FallSpeed.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	MovementMode.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	StateTimeRemaining.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	MovementTimers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	StateFlags.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Params.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	ParamLanes.RemoveAtSwap(Index);
+	Significance.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	TickInterval.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	AccumulatedTime.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	if (Pawns.IsValidIndex(Index))
+	{
+		Pawns[Index]->BatchedMovementIndex = Index;
+	}
+	Pawn->BatchedMovementIndex = INDEX_NONE;
+}
+
+void UPracticeMovementSubsystem::SetInputDirection(int32 Index, const FVector2D& NewInputDirection)
+{
+	if (InputDirection.IsValidIndex(Index))
+	{
+		InputDirection[Index] = NewInputDirection;
+	}
+}
+
+void UPracticeMovementSubsystem::RequestJump(int32 Index)
+{
+	if (StateFlags.IsValidIndex(Index))
+	{
+		StateFlags[Index] |= EPracticeMovementFlags::JumpRequested;
+	}
+}
+
+void UPracticeMovementSubsystem::RequestToggleDrone(int32 Index)
+{
+	if (StateFlags.IsValidIndex(Index))
+	{
+		StateFlags[Index] |= EPracticeMovementFlags::DroneToggleRequested;
+	}
+}
+
+void UPracticeMovementSubsystem::SetSignificance(int32 Index, EPracticeSignificance NewSignificance, float NewTickInterval)
+{
+	if (Significance.IsValidIndex(Index))
+	{
+		Significance[Index] = NewSignificance;
+		TickInterval[Index] = NewTickInterval;
+	}
+}
+
+void UPracticeMovementSubsystem::AddActorTickTime(double Seconds)
+{
+	ActorTickSeconds += Seconds;
+	++ActorTickCount;
+}
+
+void UPracticeMovementSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double StartTime = FPlatformTime::Seconds();
+	{
+		PRACTICE_MOVEMENT_STAT_SCOPE(BatchedMovement);
+		PRACTICE_MOVEMENT_SCOPE(BatchedPass);
+
+		const int32 NumPawns = Pawns.Num();
+		StepTime.SetNumUninitialized(NumPawns, EAllowShrinking::No);
+		ControlYaw.SetNumUninitialized(NumPawns, EAllowShrinking::No);
+		JumpYaw.SetNumUninitialized(NumPawns, EAllowShrinking::No);
+		ActorYaw.SetNumUninitialized(NumPawns, EAllowShrinking::No);
+		TargetYaw.SetNumUninitialized(NumPawns, EAllowShrinking::No);
+		GroundLane.SetNumUninitialized(NumPawns, EAllowShrinking::No);
+		AirLane.SetNumUninitialized(NumPawns, EAllowShrinking::No);
+		TargetVelocity.SetNumUninitialized(NumPawns, EAllowShrinking::No);
+		AirSpeedX.SetNumUninitialized(NumPawns, EAllowShrinking::No);
+		AirSpeedY.SetNumUninitialized(NumPawns, EAllowShrinking::No);
+		AirSpeedZ.SetNumUninitialized(NumPawns, EAllowShrinking::No);
+		HorizontalDelta.SetNumUninitialized(NumPawns, EAllowShrinking::No);
+		VerticalDelta.SetNumUninitialized(NumPawns, EAllowShrinking::No);
+
+		// 1. Controller, Actor에 접근하는 부분은 Game Thread에서 처리
+		{
+			PRACTICE_MOVEMENT_STAT_SCOPE(BatchedGather);
+			for (int32 Index = 0; Index < NumPawns; ++Index)
+			{
+				Gather(Index, DeltaTime);
+			}
+		}
+
+		// 2. 순수 계산은 Worker Thread에서 병렬로 처리
+		// 각 Pawn은 자기 Index의 값만 읽고 쓰기 때문에 실행 순서와 상관없이 결과가 같다.
+		// SIMD 계산이 Lane 단위로 처리할 수 있도록 LaneWidth의 배수 크기 구간으로 나눈다.
+		{
+			PRACTICE_MOVEMENT_STAT_SCOPE(BatchedIntegrate);
+			const EParallelForFlags ParallelForFlags = CVarPracticeMovementParallelIntegrate.GetValueOnGameThread()
+				? EParallelForFlags::None
+				: EParallelForFlags::ForceSingleThread;
+			const bool bUseKernels = CVarPracticeMovementSimdKernels.GetValueOnGameThread() != 0;
+#if !UE_BUILD_SHIPPING
+			const bool bValidateKernels = bUseKernels && CVarPracticeMovementValidateKernels.GetValueOnGameThread() != 0;
+#else
+			const bool bValidateKernels = false;
+#endif
+			const int32 BlockSize = Align(FMath::Max(CVarPracticeMovementParallelMinBatch.GetValueOnGameThread(), PracticeMovementKernels::LaneWidth), PracticeMovementKernels::LaneWidth);
+			const int32 NumBlocks = FMath::DivideAndRoundUp(NumPawns, BlockSize);
+			ParallelFor(TEXT("PracticeMovement.Integrate"), NumBlocks, 1,
+				[this, BlockSize, NumPawns, bUseKernels, bValidateKernels](int32 Block)
+				{
+					const int32 Begin = Block * BlockSize;
+					IntegrateRange(Begin, FMath::Min(Begin + BlockSize, NumPawns), bUseKernels, bValidateKernels);
+				},
+				ParallelForFlags);
+		}
+
+		// 3. 충돌 처리와 회전 적용은 Game Thread에서 Index 순서대로 처리
+		{
+			PRACTICE_MOVEMENT_STAT_SCOPE(BatchedCommit);
+			for (int32 Index = 0; Index < NumPawns; ++Index)
+			{
+				Commit(Index);
+			}
+		}
+	}
+	PublishStats(FPlatformTime::Seconds() - StartTime);
+}
+
+void UPracticeMovementSubsystem::Gather(int32 Index, float DeltaTime)
+{
+	APracticeCharacter* Pawn = Pawns[Index];
+	// 버튼 입력은 이미 StateFlags로 전달되었으므로 입력 기록용 값만 비운다.
+	Pawn->PendingInputButtons = 0;
+	if (!Pawn->Controller)
+	{
+		// Controller가 없으면 이번 프레임은 이동하지 않는다.
+		StateFlags[Index] |= EPracticeMovementFlags::Inactive;
+		return;
+	}
+	StateFlags[Index] &= ~EPracticeMovementFlags::Inactive;
+
+	// 갱신 간격이 있으면 시간을 누적하고 간격이 지났을 때 한 번에 갱신한다.
+	AccumulatedTime[Index] += DeltaTime;
+	if (AccumulatedTime[Index] < TickInterval[Index])
+	{
+		StateFlags[Index] |= EPracticeMovementFlags::Inactive;
+		return;
+	}
+	StepTime[Index] = AccumulatedTime[Index];
+	AccumulatedTime[Index] = 0.f;
+	DeltaTime = StepTime[Index];
+
+	// 드론 전환은 드물게 일어나고 Pawn의 드론 상태를 사용하므로 Pawn에서 처리한다.
+	if (StateFlags[Index] & EPracticeMovementFlags::DroneToggleRequested)
+	{
+		StateFlags[Index] &= ~EPracticeMovementFlags::DroneToggleRequested;
+		WriteBack(Index);
+		Pawn->HandleMovementEvent(EPracticeMovementEvent::ToggleDrone);
+		ReadBack(Index);
+	}
+
+	// 개별 Tick에서는 입력 시점에 점프하므로 Controller 회전이 갱신되기 전의 Yaw를 사용한다.
+	JumpYaw[Index] = Pawn->Controller->GetControlRotation().Yaw;
+
+	// APracticeCharacter::Tick과 같은 순서로 처리한다.
+	Pawn->UpdateControllerRotation(DeltaTime);
+	ControlYaw[Index] = Pawn->Controller->GetControlRotation().Yaw;
+	ActorYaw[Index] = Pawn->GetActorRotation().Yaw;
+}
+
+void UPracticeMovementSubsystem::IntegrateRange(int32 Begin, int32 End, bool bUseKernels, bool bValidateKernels)
+{
+	for (int32 Index = Begin; Index < End; ++Index)
+	{
+		Integrate(Index);
+	}
+
+	if (bUseKernels)
+	{
+#if !UE_BUILD_SHIPPING
+		if (bValidateKernels)
+		{
+			IntegrateLanesValidated(Begin, End);
+		}
+		else
+#endif
+		{
+			IntegrateLanes(Begin, End);
+		}
+	}
+	else
+	{
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			IntegrateLaneScalar(Index, Velocity[Index], FallSpeed[Index], MoveDirection[Index]);
+		}
+	}
+
+	for (int32 Index = Begin; Index < End; ++Index)
+	{
+		UpdateDelta(Index);
+	}
+}
+
+void UPracticeMovementSubsystem::Integrate(int32 Index)
+{
+	uint8& Flags = StateFlags[Index];
+	Flags &= ~EPracticeMovementFlags::RotationDirty;
+	GroundLane[Index] = 0.f;
+	AirLane[Index] = 0.f;
+	if (Flags & EPracticeMovementFlags::Inactive)
+	{
+		return;
+	}
+
+	const float DeltaTime = StepTime[Index];
+
+	const FPracticeMovementParams& PawnParams = Params[Index];
+
+	// 개별 Tick에서는 입력 콜백에서 점프를 먼저 처리하므로 같은 순서로 처리한다.
+	if (Flags & EPracticeMovementFlags::JumpRequested)
+	{
+		Flags &= ~EPracticeMovementFlags::JumpRequested;
+		HandleEvent(Index, EPracticeMovementEvent::Jump);
+	}
+
+	const FVector InputWorldDirection = FPracticeYawBasis(ControlYaw[Index]).ToWorld(InputDirection[Index]);
+
+	switch (MovementMode[Index])
+	{
+	// 지상 이동
+	case EPracticeMovementMode::Walking:
+	case EPracticeMovementMode::Landing:
+	{
+		// 속력, 낙하 속도는 IntegrateLanes에서 계산한다. 낙하 속도는 0에서 시작한다.
+		GroundLane[Index] = 1.f;
+		TargetVelocity[Index] = InputDirection[Index].IsZero() ? 0.0f : PawnParams.MoveSpeed;
+		MoveDirection[Index] = InputWorldDirection;
+
+		if (!InputWorldDirection.IsZero())
+		{
+			// 멀리 있으면 보간하지 않는다.
+			const float FaceYaw = PracticeMovement::GetFaceYaw(InputWorldDirection);
+			TargetYaw[Index] = Significance[Index] == EPracticeSignificance::Far
+				? FaceYaw
+				: PracticeMovement::InterpYawTo(ActorYaw[Index], FaceYaw, DeltaTime, PawnParams.TurnSmoothingDamp);
+			Flags |= EPracticeMovementFlags::RotationDirty;
+		}
+		break;
+	}
+	// 공중 이동
+	case EPracticeMovementMode::Jumping:
+	case EPracticeMovementMode::Falling:
+	{
+		// 최대 속도 제한은 IntegrateLanes에서 계산한다.
+		AirLane[Index] = 1.f;
+		const FVector AirSpeed = PracticeMovement::GetAirSpeed(Velocity[Index], MoveDirection[Index], InputWorldDirection, PawnParams, DeltaTime);
+		AirSpeedX[Index] = AirSpeed.X;
+		AirSpeedY[Index] = AirSpeed.Y;
+		AirSpeedZ[Index] = AirSpeed.Z;
+		break;
+	}
+	// 드론 이동은 Commit에서 Pawn이 처리한다.
+	case EPracticeMovementMode::Drone:
+	default:
+		break;
+	}
+}
+
+void UPracticeMovementSubsystem::IntegrateLanes(int32 Begin, int32 End)
+{
+	const int32 Num = End - Begin;
+	PracticeMovementKernels::CalculateVelocity(Velocity.GetData() + Begin, TargetVelocity.GetData() + Begin, ParamLanes.AccelDamp.GetData() + Begin,
+		StepTime.GetData() + Begin, GroundLane.GetData() + Begin, Num);
+	PracticeMovementKernels::UpdateFallSpeed(FallSpeed.GetData() + Begin, ParamLanes.Gravity.GetData() + Begin, ParamLanes.FallMultiplier.GetData() + Begin,
+		ParamLanes.TerminalSpeed.GetData() + Begin, StepTime.GetData() + Begin, GroundLane.GetData() + Begin, AirLane.GetData() + Begin, Num);
+	PracticeMovementKernels::ClampAirSpeed(Velocity.GetData() + Begin, AirSpeedX.GetData() + Begin, AirSpeedY.GetData() + Begin, AirSpeedZ.GetData() + Begin,
+		ParamLanes.MoveSpeed.GetData() + Begin, AirLane.GetData() + Begin, Num);
+
+	for (int32 Index = Begin; Index < End; ++Index)
+	{
+		if (AirLane[Index] > 0.f)
+		{
+			MoveDirection[Index] = FVector(AirSpeedX[Index], AirSpeedY[Index], AirSpeedZ[Index]);
+		}
+	}
+}
+
+void UPracticeMovementSubsystem::IntegrateLaneScalar(int32 Index, float& OutVelocity, float& OutFallSpeed, FVector& OutMoveDirection) const
+{
+	const FPracticeMovementParams& PawnParams = Params[Index];
+	const float DeltaTime = StepTime[Index];
+	if (GroundLane[Index] > 0.f)
+	{
+		OutVelocity = PracticeMovement::CalculateVelocity(Velocity[Index], TargetVelocity[Index], PawnParams.AccelDamp, DeltaTime);
+		OutFallSpeed = PracticeMovement::UpdateFallSpeed(0.f, PawnParams, DeltaTime);
+	}
+	else if (AirLane[Index] > 0.f)
+	{
+		const FVector AirSpeed(AirSpeedX[Index], AirSpeedY[Index], AirSpeedZ[Index]);
+		PracticeMovement::ClampAirSpeed(AirSpeed, PawnParams.MoveSpeed, OutVelocity, OutMoveDirection);
+		OutFallSpeed = PracticeMovement::UpdateFallSpeed(FallSpeed[Index], PawnParams, DeltaTime);
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+void UPracticeMovementSubsystem::IntegrateLanesValidated(int32 Begin, int32 End)
+{
+	// SIMD 계산 전 상태로 Scalar 결과를 먼저 구해둔다.
+	const int32 Num = End - Begin;
+	TArray<float, TInlineAllocator<256>> ExpectedVelocity;
+	TArray<float, TInlineAllocator<256>> ExpectedFallSpeed;
+	TArray<FVector, TInlineAllocator<256>> ExpectedMoveDirection;
+	ExpectedVelocity.SetNumUninitialized(Num);
+	ExpectedFallSpeed.SetNumUninitialized(Num);
+	ExpectedMoveDirection.SetNumUninitialized(Num);
+	for (int32 Index = Begin; Index < End; ++Index)
+	{
+		const int32 Lane = Index - Begin;
+		ExpectedVelocity[Lane] = Velocity[Index];
+		ExpectedFallSpeed[Lane] = FallSpeed[Index];
+		ExpectedMoveDirection[Lane] = MoveDirection[Index];
+		IntegrateLaneScalar(Index, ExpectedVelocity[Lane], ExpectedFallSpeed[Lane], ExpectedMoveDirection[Lane]);
+	}
+
+	IntegrateLanes(Begin, End);
+
+	const auto IsNearlyEqual = [](const double A, const double B)
+	{
+		return FMath::IsNearlyEqual(A, B, KernelTolerance * FMath::Max(1.0, FMath::Abs(B)));
+	};
+	for (int32 Index = Begin; Index < End; ++Index)
+	{
+		const int32 Lane = Index - Begin;
+		if (!IsNearlyEqual(Velocity[Index], ExpectedVelocity[Lane])
+			|| !IsNearlyEqual(FallSpeed[Index], ExpectedFallSpeed[Lane])
+			|| !MoveDirection[Index].Equals(ExpectedMoveDirection[Lane], KernelTolerance))
+		{
+			// 같은 구간에서는 첫 번째 차이만 출력한다.
+			UE_LOG(LogPracticeMovement, Warning, TEXT("SIMD kernel mismatch [%d] %s : Velocity %f / %f, FallSpeed %f / %f, MoveDirection %s / %s"),
+				Index, GroundLane[Index] > 0.f ? TEXT("Ground") : TEXT("Air"),
+				Velocity[Index], ExpectedVelocity[Lane], FallSpeed[Index], ExpectedFallSpeed[Lane],
+				*MoveDirection[Index].ToString(), *ExpectedMoveDirection[Lane].ToString());
+			return;
+		}
+	}
+}
+#endif
+
+void UPracticeMovementSubsystem::UpdateDelta(int32 Index)
+{
+	if (GroundLane[Index] <= 0.f && AirLane[Index] <= 0.f)
+	{
+		return;
+	}
+
+	const float DeltaTime = StepTime[Index];
+	HorizontalDelta[Index] = MoveDirection[Index] * Velocity[Index] * DeltaTime;
+	VerticalDelta[Index] = FVector::UpVector * FallSpeed[Index] * DeltaTime;
+}
+
+void UPracticeMovementSubsystem::Commit(int32 Index)
+{
+	uint8& Flags = StateFlags[Index];
+	if (Flags & EPracticeMovementFlags::Inactive)
+	{
+		return;
+	}
+
+	const float DeltaTime = StepTime[Index];
+
+	APracticeCharacter* Pawn = Pawns[Index];
+	if (MovementMode[Index] == EPracticeMovementMode::Drone)
+	{
+		Pawn->DroneMove(DeltaTime);
+	}
+	else
+	{
+		if (Flags & EPracticeMovementFlags::RotationDirty)
+		{
+			Pawn->SetActorRotation(PracticeMovement::MakeYawQuat(TargetYaw[Index]));
+		}
+
+		// 멀리 있는 지상 이동은 Sweep, 지면 검사 없이 처리한다.
+		if (Significance[Index] == EPracticeSignificance::Far && PracticeMovement::IsGroundMode(MovementMode[Index]))
+		{
+			FallSpeed[Index] = 0.f;
+			Pawn->KinematicMove(HorizontalDelta[Index], Pawn->GetSeparationDelta(DeltaTime));
+		}
+		else
+		{
+			switch (Pawn->SweepMove(HorizontalDelta[Index] + Pawn->GetSeparationDelta(DeltaTime), VerticalDelta[Index]))
+			{
+			case EPracticeSweepResult::Ground:
+				// 착지 잠금이 0이면 착지와 함께 보관한 점프를 처리할 수 있다.
+				HandleEventAfterMove(Index, EPracticeMovementEvent::Land);
+				break;
+			case EPracticeSweepResult::Air:
+				HandleEvent(Index, EPracticeMovementEvent::LeaveGround);
+				break;
+			case EPracticeSweepResult::Wall:
+			default:
+				break;
+			}
+		}
+	}
+
+	TickMovementMode(Index, DeltaTime);
+
+	Pawn->UpdateCamera();
+
+	WriteBack(Index);
+}
+
+void UPracticeMovementSubsystem::TickMovementMode(int32 Index, float DeltaTime)
+{
+	// APracticeCharacter::TickMovementMode와 같이 이동이 끝난 뒤에 줄인다.
+	if (PracticeMovement::TickStateTime(StateTimeRemaining[Index], DeltaTime))
+	{
+		HandleEventAfterMove(Index, EPracticeMovementEvent::Timeout);
+	}
+	PracticeMovement::TickMovementTimers(MovementTimers[Index], MovementMode[Index], DeltaTime);
+}
+
+void UPracticeMovementSubsystem::HandleEventAfterMove(int32 Index, EPracticeMovementEvent Event)
+{
+	// 보관한 점프는 Controller 회전 갱신 뒤에 처리되므로 갱신된 Yaw를 사용하고 회전을 바로 적용한다.
+	JumpYaw[Index] = ControlYaw[Index];
+	StateFlags[Index] &= ~EPracticeMovementFlags::RotationDirty;
+	HandleEvent(Index, Event);
+	if (StateFlags[Index] & EPracticeMovementFlags::RotationDirty)
+	{
+		Pawns[Index]->SetActorRotation(PracticeMovement::MakeYawQuat(TargetYaw[Index]));
+	}
+}
+
+void UPracticeMovementSubsystem::HandleEvent(int32 Index, EPracticeMovementEvent Event)
+{
+	// APracticeCharacter::HandleMovementEvent와 같은 전이 표와 Enter / Exit를 사용한다.
+	// Integrate에서도 호출되므로 자기 Index의 값만 수정해야 한다.
+	const FPracticeMovementParams& PawnParams = Params[Index];
+	FPracticeMovementTimers& Timers = MovementTimers[Index];
+	const EPracticeMovementMode PrevMode = MovementMode[Index];
+
+	EPracticeMovementMode NextMode = PracticeMovement::GetNextMode(PrevMode, Event);
+	if (Event == EPracticeMovementEvent::Jump)
+	{
+		NextMode = PracticeMovement::ResolveJump(PrevMode, Timers, PawnParams);
+		if (NextMode == PrevMode && Timers.IsActive(EPracticeMovementTimer::JumpBuffer))
+		{
+			INC_DWORD_STAT(STAT_PracticeMovementTimerStarts);
+		}
+	}
+
+	if (NextMode == PrevMode)
+	{
+		return;
+	}
+
+	// Exit
+	StateTimeRemaining[Index] = 0.f;
+	MovementMode[Index] = NextMode;
+
+	// Enter
+	switch (NextMode)
+	{
+	case EPracticeMovementMode::Walking:
+		if (Timers.IsActive(EPracticeMovementTimer::JumpBuffer))
+		{
+			INC_DWORD_STAT(STAT_PracticeBufferedJumps);
+			HandleEvent(Index, EPracticeMovementEvent::Jump);
+		}
+		break;
+	case EPracticeMovementMode::Falling:
+		if (PracticeMovement::IsGroundMode(PrevMode) && PawnParams.CoyoteTime > 0.f)
+		{
+			Timers.Start(EPracticeMovementTimer::Coyote, PawnParams.CoyoteTime);
+			INC_DWORD_STAT(STAT_PracticeMovementTimerStarts);
+		}
+		break;
+	case EPracticeMovementMode::Jumping:
+	{
+		if (PrevMode == EPracticeMovementMode::Falling)
+		{
+			INC_DWORD_STAT(STAT_PracticeCoyoteJumps);
+		}
+		Timers.Clear(EPracticeMovementTimer::JumpBuffer);
+		Timers.Clear(EPracticeMovementTimer::Coyote);
+
+		Velocity[Index] = FMath::Clamp(Velocity[Index], 0.f, PawnParams.MaxJumpHorizontalVelocity);
+		FallSpeed[Index] = PawnParams.JumpVelocity;
+
+		const FVector JumpDirection = PracticeMovement::GetMoveDirection(JumpYaw[Index], InputDirection[Index]);
+		if (!JumpDirection.IsZero())
+		{
+			TargetYaw[Index] = PracticeMovement::GetFaceYaw(JumpDirection);
+			StateFlags[Index] |= EPracticeMovementFlags::RotationDirty;
+		}
+		break;
+	}
+	case EPracticeMovementMode::Landing:
+		StateTimeRemaining[Index] = PawnParams.LandingLockTime;
+		INC_DWORD_STAT(STAT_PracticeLandings);
+		if (StateTimeRemaining[Index] > 0.f)
+		{
+			INC_DWORD_STAT(STAT_PracticeMovementTimerStarts);
+		}
+		else
+		{
+			HandleEvent(Index, EPracticeMovementEvent::Timeout);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void UPracticeMovementSubsystem::WriteBack(int32 Index)
+{
+	APracticeCharacter* Pawn = Pawns[Index];
+
+	Pawn->InputDirection = InputDirection[Index];
+	Pawn->Velocity = Velocity[Index];
+	Pawn->MoveDirection = MoveDirection[Index];
+	Pawn->FallSpeed = FallSpeed[Index];
+	Pawn->MovementMode = MovementMode[Index];
+	Pawn->StateTimeRemaining = StateTimeRemaining[Index];
+	Pawn->MovementTimers = MovementTimers[Index];
+	Pawn->UpdateMovementModeFlags();
+}
+
+void UPracticeMovementSubsystem::ReadBack(int32 Index)
+{
+	const APracticeCharacter* Pawn = Pawns[Index];
+
+	Velocity[Index] = Pawn->Velocity;
+	MoveDirection[Index] = Pawn->MoveDirection;
+	FallSpeed[Index] = Pawn->FallSpeed;
+	MovementMode[Index] = Pawn->MovementMode;
+	StateTimeRemaining[Index] = Pawn->StateTimeRemaining;
+	MovementTimers[Index] = Pawn->MovementTimers;
+}
+
+void UPracticeMovementSubsystem::PublishStats(double BatchedSeconds)
+{
+#if STATS
+	// 1000 Pawn 기준으로 환산해서 개별 Tick과 배치 처리의 비용을 비교한다.
+	const int32 NumBatched = Pawns.Num();
+	SET_DWORD_STAT(STAT_PracticeBatchedPawns, NumBatched);
+	SET_FLOAT_STAT(STAT_PracticeBatchedMsPer1000, NumBatched > 0 ? BatchedSeconds * 1000.0 * 1000.0 / NumBatched : 0.0);
+
+	SET_DWORD_STAT(STAT_PracticeActorTickPawns, ActorTickCount);
+	SET_FLOAT_STAT(STAT_PracticeActorTickMsPer1000, ActorTickCount > 0 ? ActorTickSeconds * 1000.0 * 1000.0 / ActorTickCount : 0.0);
+#endif
+
+	ActorTickSeconds = 0.0;
+	ActorTickCount = 0;
+}
@@ -0,0 +1,150 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PracticeMovingPlatform.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "UObject/ConstructorHelpers.h"
+#include "PracticeGroundCacheSubsystem.h"
+#include "Sparta_Practice_7.h"
+
+static FAutoConsoleCommandWithWorldAndArgs PracticeSpawnPlatformCommand(
+	TEXT("practice.SpawnPlatform"),
+	TEXT("practice.SpawnPlatform [X] [Y] [Z] [주기] : 플레이어 앞에 움직이는 발판을 만든다."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&APracticeMovingPlatform::SpawnPlatforms));
+
+static FAutoConsoleCommandWithWorld PracticeClearPlatformsCommand(
+	TEXT("practice.ClearPlatforms"),
+	TEXT("practice.SpawnPlatform으로 만든 발판을 모두 제거한다."),
+	FConsoleCommandWithWorldDelegate::CreateStatic(&APracticeMovingPlatform::ClearPlatforms));
+
+APracticeMovingPlatform::APracticeMovingPlatform()
+{
+	PrimaryActorTick.bCanEverTick = true;
+
+	// 서버에서 만든 발판도 Client에 보이고, Client의 발판 위 Pawn이 같은 위치에서 움직이도록 서버의 이동을 복제한다.
+	bReplicates = true;
+	SetReplicateMovement(true);
+
+	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
+	MeshComponent->SetMobility(EComponentMobility::Movable);
+	MeshComponent->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+	SetRootComponent(MeshComponent);
+
+	// 기본 Cube(100cm)를 4m x 4m x 20cm 발판으로 사용한다.
+	static ConstructorHelpers::FObjectFinder<UStaticMesh> CubeMesh(TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (CubeMesh.Succeeded())
+	{
+		MeshComponent->SetStaticMesh(CubeMesh.Object);
+		MeshComponent->SetRelativeScale3D(FVector(4.0f, 4.0f, 0.2f));
+	}
+
+	Travel = FVector(0.0f, 600.0f, 0.0f);
+	Period = 6.0f;
+	PhaseOffset = 0.0f;
+	YawSpeed = 0.0f;
+}
+
+void APracticeMovingPlatform::BeginPlay()
+{
+	Super::BeginPlay();
+
+	StartLocation = GetActorLocation();
+	StartRotation = GetActorRotation();
+	ElapsedTime = PhaseOffset * Period;
+
+	// 움직이는 범위 전체를 지면 높이 캐시에서 제외한다. 회전하면 수평 반지름만큼 넓힌다.
+	if (UPracticeGroundCacheSubsystem* GroundCacheSubsystem = GetWorld()->GetSubsystem<UPracticeGroundCacheSubsystem>())
+	{
+		FBox Bounds = MeshComponent->Bounds.GetBox();
+		Bounds += Bounds.ShiftBy(Travel);
+		if (YawSpeed != 0.0f)
+		{
+			Bounds = Bounds.ExpandBy(FVector(MeshComponent->Bounds.SphereRadius, MeshComponent->Bounds.SphereRadius, 0.0f));
+		}
+		GroundCacheSubsystem->MarkDynamic(Bounds);
+	}
+}
+
+void APracticeMovingPlatform::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Client는 복제된 이동을 따른다.
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	ElapsedTime += DeltaTime;
+
+	// 시작 위치와 끝 위치 사이를 Cosine 곡선으로 왕복해서 양 끝에서 부드럽게 멈춘다.
+	const float Alpha = 0.5f - 0.5f * FMath::Cos(UE_TWO_PI * ElapsedTime / FMath::Max(Period, 0.1f));
+	const FRotator NewRotation(StartRotation.Pitch, StartRotation.Yaw + YawSpeed * ElapsedTime, StartRotation.Roll);
+	SetActorLocationAndRotation(StartLocation + Travel * Alpha, NewRotation);
+}
+
+void APracticeMovingPlatform::SpawnPlatforms(const TArray<FString>& Args, UWorld* World)
+{
+	if (!World || !World->GetAuthGameMode())
+	{
+		UE_LOG(LogPracticeMovement, Warning, TEXT("practice.SpawnPlatform : requires authority (server or standalone)"));
+		return;
+	}
+
+	FVector NewTravel(0.0f, 600.0f, 0.0f);
+	if (Args.Num() >= 3)
+	{
+		NewTravel = FVector(FCString::Atof(*Args[0]), FCString::Atof(*Args[1]), FCString::Atof(*Args[2]));
+	}
+	const float NewPeriod = Args.Num() > 3 ? FCString::Atof(*Args[3]) : 6.0f;
+
+	// 플레이어의 발 높이, 앞 5m에 만든다.
+	const APlayerController* PlayerController = World->GetFirstPlayerController();
+	const APawn* PlayerPawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+	if (!PlayerPawn)
+	{
+		return;
+	}
+	const FVector Forward = PlayerPawn->GetActorForwardVector().GetSafeNormal2D();
+	const FVector FootLocation = PlayerPawn->GetActorLocation() - FVector(0.0f, 0.0f, PlayerPawn->GetSimpleCollisionHalfHeight());
+	const FTransform SpawnTransform(FRotator(0.0f, Forward.Rotation().Yaw, 0.0f), FootLocation + Forward * 500.0f);
+
+	APracticeMovingPlatform* Platform = World->SpawnActorDeferred<APracticeMovingPlatform>(
+		APracticeMovingPlatform::StaticClass(), SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (!Platform)
+	{
+		return;
+	}
+	Platform->Travel = NewTravel;
+	Platform->Period = FMath::Max(NewPeriod, 0.1f);
+	Platform->bSpawnedByCommand = true;
+	Platform->FinishSpawning(SpawnTransform);
+
+	UE_LOG(LogPracticeMovement, Log, TEXT("practice.SpawnPlatform : travel %s, period %.1f s"), *NewTravel.ToString(), Platform->Period);
+}
+
+void APracticeMovingPlatform::ClearPlatforms(UWorld* World)
+{
+	if (!World || !World->GetAuthGameMode())
+	{
+		return;
+	}
+
+	int32 NumCleared = 0;
+	for (TActorIterator<APracticeMovingPlatform> It(World); It; ++It)
+	{
+		if (It->bSpawnedByCommand)
+		{
+			It->Destroy();
+			++NumCleared;
+		}
+	}
+
+	UE_LOG(LogPracticeMovement, Log, TEXT("practice.ClearPlatforms : %d platforms"), NumCleared);
+}
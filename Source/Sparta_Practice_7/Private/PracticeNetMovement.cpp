@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PracticeNetMovement.h"
+
+void FPracticeNetMove::SetMoveInput(const FVector2D& MoveInput)
+{
+	MoveX = static_cast<int8>(FMath::RoundToInt32(FMath::Clamp(MoveInput.X, -1.0, 1.0) * 127.0));
+	MoveY = static_cast<int8>(FMath::RoundToInt32(FMath::Clamp(MoveInput.Y, -1.0, 1.0) * 127.0));
+}
+
+void FPracticeNetMove::SetControlRotation(const FRotator& ControlRotation)
+{
+	Pitch = FRotator::CompressAxisToShort(ControlRotation.Pitch);
+	Yaw = FRotator::CompressAxisToShort(ControlRotation.Yaw);
+	Roll = FRotator::CompressAxisToShort(ControlRotation.Roll);
+	if (Roll != 0)
+	{
+		Flags |= HasRoll;
+	}
+}
+
+void FPracticeNetMove::SetDroneThrust(float DroneThrustInput)
+{
+	Thrust = static_cast<int8>(FMath::RoundToInt32(FMath::Clamp(DroneThrustInput, -1.0f, 1.0f) * 127.0f));
+	if (Thrust != 0)
+	{
+		Flags |= HasThrust;
+	}
+}
+
+FRotator FPracticeNetMove::GetControlRotation() const
+{
+	return FRotator(
+		FRotator::DecompressAxisFromShort(Pitch),
+		FRotator::DecompressAxisFromShort(Yaw),
+		FRotator::DecompressAxisFromShort(Roll));
+}
+
+bool FPracticeNetMove::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	// 기본 : TimeStamp(가변 길이) + 8 Byte, 드론 입력이 있을 때만 추가로 보낸다.
+	Ar.SerializeIntPacked(TimeStamp);
+	Ar << DeltaTimeMs << MoveX << MoveY << Pitch << Yaw << Flags;
+
+	if (Flags & HasRoll)
+	{
+		Ar << Roll;
+	}
+	else if (Ar.IsLoading())
+	{
+		Roll = 0;
+	}
+
+	if (Flags & HasThrust)
+	{
+		Ar << Thrust;
+	}
+	else if (Ar.IsLoading())
+	{
+		Thrust = 0;
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
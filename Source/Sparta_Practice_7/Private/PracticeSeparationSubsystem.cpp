@@ -0,0 +1,313 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PracticeSeparationSubsystem.h"
+
+#include "Components/CapsuleComponent.h"
+#include "PracticeCharacter.h"
+#include "PracticeMovementStats.h"
+
+DEFINE_STAT(STAT_PracticeSeparationGrid);
+DEFINE_STAT(STAT_PracticeSeparationQuery);
+DEFINE_STAT(STAT_PracticeSeparationPawns);
+DEFINE_STAT(STAT_PracticeSeparationCellMoves);
+DEFINE_STAT(STAT_PracticeSeparationNeighborChecks);
+
+static TAutoConsoleVariable<int32> CVarPracticeSeparationEnable(
+	TEXT("practice.Separation.Enable"),
+	1,
+	TEXT("플레이어가 조종하지 않는 Pawn끼리 Sweep 충돌 대신 격자 기반 밀어내기를 사용한다. Spawn 이후의 Pawn부터 적용된다.\n")
+	TEXT("0: Pawn 채널로 충돌, 1: 밀어내기 사용"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPracticeSeparationCellSize(
+	TEXT("practice.Separation.CellSize"),
+	200.0f,
+	TEXT("격자 한 칸의 크기, 밀어내기 거리(두 Capsule 반지름의 합)보다 커야 한다."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPracticeSeparationStrength(
+	TEXT("practice.Separation.Strength"),
+	600.0f,
+	TEXT("완전히 겹쳤을 때의 밀어내는 속도(cm/s), 겹친 비율에 비례한다."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPracticeSeparationPadding(
+	TEXT("practice.Separation.Padding"),
+	10.0f,
+	TEXT("Capsule 반지름에 더하는 여유 거리"),
+	ECVF_Default);
+
+void UPracticeSeparationSubsystem::Deinitialize()
+{
+	Pawns.Reset();
+	Location.Reset();
+	Radius.Reset();
+	HalfHeight.Reset();
+	PawnCell.Reset();
+	SeparationVelocity.Reset();
+	ObjectType.Reset();
+	CrowdResponse.Reset();
+	Cells.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UPracticeSeparationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UPracticeSeparationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPracticeSeparationSubsystem, STATGROUP_Tickables);
+}
+
+void UPracticeSeparationSubsystem::RegisterPawn(APracticeCharacter* Pawn)
+{
+	check(Pawn);
+	if (!CVarPracticeSeparationEnable.GetValueOnGameThread() || Pawn->SeparationIndex != INDEX_NONE)
+	{
+		return;
+	}
+	if (CellSize <= 0.0f)
+	{
+		CellSize = FMath::Max(CVarPracticeSeparationCellSize.GetValueOnGameThread(), 1.0f);
+	}
+
+	const int32 Index = Pawns.Add(Pawn);
+	Location.Add(Pawn->GetActorLocation());
+	Radius.Add(Pawn->CapsuleComponent->GetScaledCapsuleRadius());
+	HalfHeight.Add(Pawn->CapsuleComponent->GetScaledCapsuleHalfHeight());
+	PawnCell.Add(GetCell(Location[Index]));
+	SeparationVelocity.Add(FVector::ZeroVector);
+	ObjectType.Add(Pawn->CapsuleComponent->GetCollisionObjectType());
+	CrowdResponse.Add(Pawn->CapsuleComponent->GetCollisionResponseToChannel(ECC_PracticeCrowd));
+	AddToCell(Index, PawnCell[Index]);
+	Pawn->SeparationIndex = Index;
+
+	UpdatePawnCollision(Pawn);
+}
+
+void UPracticeSeparationSubsystem::UpdatePawnCollision(APracticeCharacter* Pawn)
+{
+	const int32 Index = Pawn->SeparationIndex;
+	if (!Pawns.IsValidIndex(Index) || Pawns[Index] != Pawn)
+	{
+		return;
+	}
+
+	UCapsuleComponent* Capsule = Pawn->CapsuleComponent;
+	if (Pawn->CanBePushed())
+	{
+		// 밀려나는 Pawn끼리는 Sweep에서 막지 않고 밀어내기로 처리한다.
+		Capsule->SetCollisionObjectType(ECC_PracticeCrowd);
+		Capsule->SetCollisionResponseToChannel(ECC_PracticeCrowd, ECR_Ignore);
+	}
+	else
+	{
+		// 밀려나지 않는 Pawn이 군중을 통과하지 않도록 원래 충돌을 유지한다.
+		Capsule->SetCollisionObjectType(ObjectType[Index]);
+		Capsule->SetCollisionResponseToChannel(ECC_PracticeCrowd, CrowdResponse[Index]);
+	}
+}
+
+void UPracticeSeparationSubsystem::UnregisterPawn(APracticeCharacter* Pawn)
+{
+	check(Pawn);
+	const int32 Index = Pawn->SeparationIndex;
+	if (!Pawns.IsValidIndex(Index) || Pawns[Index] != Pawn)
+	{
+		return;
+	}
+
+	RemoveFromCell(Index, PawnCell[Index]);
+	const ECollisionChannel PrevObjectType = ObjectType[Index];
+	const ECollisionResponse PrevCrowdResponse = CrowdResponse[Index];
+
+	// 마지막 Pawn을 빈자리로 옮기고 셀에 기록된 Index도 바꾼다.
+	const int32 LastIndex = Pawns.Num() - 1;
+	if (Index != LastIndex)
+	{
+		if (TArray<int32>* LastCell = Cells.Find(PawnCell[LastIndex]))
+		{
+			const int32 Slot = LastCell->Find(LastIndex);
+			if (Slot != INDEX_NONE)
+			{
+				(*LastCell)[Slot] = Index;
+			}
+		}
+	}
+
+	Pawns.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Location.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Radius.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	HalfHeight.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	PawnCell.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	SeparationVelocity.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	ObjectType.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	CrowdResponse.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	if (Pawns.IsValidIndex(Index))
+	{
+		Pawns[Index]->SeparationIndex = Index;
+	}
+	Pawn->SeparationIndex = INDEX_NONE;
+	Pawn->CapsuleComponent->SetCollisionObjectType(PrevObjectType);
+	Pawn->CapsuleComponent->SetCollisionResponseToChannel(ECC_PracticeCrowd, PrevCrowdResponse);
+}
+
+FIntPoint UPracticeSeparationSubsystem::GetCell(const FVector& InLocation) const
+{
+	return FIntPoint(FMath::FloorToInt32(InLocation.X / CellSize), FMath::FloorToInt32(InLocation.Y / CellSize));
+}
+
+void UPracticeSeparationSubsystem::AddToCell(int32 Index, const FIntPoint& Cell)
+{
+	Cells.FindOrAdd(Cell).Add(Index);
+}
+
+void UPracticeSeparationSubsystem::RemoveFromCell(int32 Index, const FIntPoint& Cell)
+{
+	if (TArray<int32>* CellPawns = Cells.Find(Cell))
+	{
+		CellPawns->RemoveSingleSwap(Index, EAllowShrinking::No);
+		// Pawn이 지나간 셀이 계속 쌓이지 않도록 빈 셀은 지운다.
+		if (CellPawns->IsEmpty())
+		{
+			Cells.Remove(Cell);
+		}
+	}
+}
+
+void UPracticeSeparationSubsystem::RebuildAll()
+{
+	Cells.Reset();
+	for (int32 Index = 0; Index < Pawns.Num(); ++Index)
+	{
+		PawnCell[Index] = GetCell(Location[Index]);
+		AddToCell(Index, PawnCell[Index]);
+	}
+}
+
+void UPracticeSeparationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// 밀어내기는 서버에서만 적용한다.
+	if (GetWorld()->IsNetMode(NM_Client))
+	{
+		return;
+	}
+
+	UpdateGrid();
+	UpdateSeparation();
+
+	SET_DWORD_STAT(STAT_PracticeSeparationPawns, Pawns.Num());
+}
+
+void UPracticeSeparationSubsystem::UpdateGrid()
+{
+	PRACTICE_MOVEMENT_STAT_SCOPE(SeparationGrid);
+
+	for (int32 Index = 0; Index < Pawns.Num(); ++Index)
+	{
+		Location[Index] = Pawns[Index]->GetActorLocation();
+	}
+
+	const float NewCellSize = FMath::Max(CVarPracticeSeparationCellSize.GetValueOnGameThread(), 1.0f);
+	if (NewCellSize != CellSize)
+	{
+		CellSize = NewCellSize;
+		RebuildAll();
+		return;
+	}
+
+	int32 NumCellMoves = 0;
+	for (int32 Index = 0; Index < Pawns.Num(); ++Index)
+	{
+		const FIntPoint NewCell = GetCell(Location[Index]);
+		if (NewCell != PawnCell[Index])
+		{
+			RemoveFromCell(Index, PawnCell[Index]);
+			AddToCell(Index, NewCell);
+			PawnCell[Index] = NewCell;
+			++NumCellMoves;
+		}
+	}
+	INC_DWORD_STAT_BY(STAT_PracticeSeparationCellMoves, NumCellMoves);
+}
+
+void UPracticeSeparationSubsystem::UpdateSeparation()
+{
+	PRACTICE_MOVEMENT_STAT_SCOPE(SeparationQuery);
+
+	const float Strength = CVarPracticeSeparationStrength.GetValueOnGameThread();
+	const float Padding = CVarPracticeSeparationPadding.GetValueOnGameThread();
+
+	int32 NumNeighborChecks = 0;
+	for (int32 Index = 0; Index < Pawns.Num(); ++Index)
+	{
+		// 밀려나지 않는 Pawn은 다른 Pawn을 밀어내기만 하고 자신의 속도는 계산하지 않는다.
+		if (!Pawns[Index]->CanBePushed())
+		{
+			SeparationVelocity[Index] = FVector::ZeroVector;
+			continue;
+		}
+
+		FVector Push = FVector::ZeroVector;
+		const FIntPoint& Cell = PawnCell[Index];
+
+		// 밀어내기 거리가 셀 크기보다 작으므로 주변 3 x 3 셀만 확인한다.
+		for (int32 OffsetY = -1; OffsetY <= 1; ++OffsetY)
+		{
+			for (int32 OffsetX = -1; OffsetX <= 1; ++OffsetX)
+			{
+				const TArray<int32>* CellPawns = Cells.Find(FIntPoint(Cell.X + OffsetX, Cell.Y + OffsetY));
+				if (!CellPawns)
+				{
+					continue;
+				}
+
+				for (const int32 Other : *CellPawns)
+				{
+					if (Other == Index)
+					{
+						continue;
+					}
+					++NumNeighborChecks;
+
+					// Capsule이 수직으로 겹치지 않으면 수평 거리와 관계없이 밀어내지 않는다.
+					const FVector Offset = Location[Index] - Location[Other];
+					if (FMath::Abs(Offset.Z) > HalfHeight[Index] + HalfHeight[Other])
+					{
+						continue;
+					}
+
+					const float MinDistance = Radius[Index] + Radius[Other] + Padding;
+					const float DistanceSquared = Offset.SizeSquared2D();
+					if (DistanceSquared >= FMath::Square(MinDistance))
+					{
+						continue;
+					}
+
+					// 겹친 비율만큼 밀어낸다. 같은 위치면 Index로 방향을 정해서 서로 반대로 밀어낸다.
+					const float Distance = FMath::Sqrt(DistanceSquared);
+					const FVector Direction = Distance > UE_KINDA_SMALL_NUMBER
+						? FVector(Offset.X / Distance, Offset.Y / Distance, 0.0f)
+						: (Index < Other ? FVector::ForwardVector : FVector::BackwardVector);
+					Push += Direction * (1.0f - Distance / MinDistance);
+				}
+			}
+		}
+
+		SeparationVelocity[Index] = Push.GetClampedToMaxSize2D(1.0f) * Strength;
+
+		// 정지한 Pawn은 Tick이 없으므로 밀려나야 하면 깨운다.
+		if (!Push.IsZero() && Pawns[Index]->IsSleeping())
+		{
+			Pawns[Index]->WakeUp();
+		}
+	}
+	INC_DWORD_STAT_BY(STAT_PracticeSeparationNeighborChecks, NumNeighborChecks);
+}
@@ -0,0 +1,194 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PracticeSignificanceSubsystem.h"
+
+#include "Camera/CameraComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "PracticeCharacter.h"
+#include "PracticeMovementStats.h"
+
+DEFINE_STAT(STAT_PracticeSignificanceNear);
+DEFINE_STAT(STAT_PracticeSignificanceMid);
+DEFINE_STAT(STAT_PracticeSignificanceFar);
+
+static TAutoConsoleVariable<int32> CVarPracticeSignificanceEnable(
+	TEXT("practice.Significance.Enable"),
+	1,
+	TEXT("카메라와의 거리에 따라 이동 갱신 빈도를 낮춘다.\n")
+	TEXT("0: 모든 Pawn을 Near로 처리, 1: 사용"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPracticeSignificanceNearDistance(
+	TEXT("practice.Significance.NearDistance"),
+	2000.0f,
+	TEXT("이 거리 이내의 Pawn은 매 프레임 갱신한다."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPracticeSignificanceMidDistance(
+	TEXT("practice.Significance.MidDistance"),
+	5000.0f,
+	TEXT("이 거리 이내의 Pawn은 MidTickRate로 갱신하고, 더 멀면 Far로 처리한다."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPracticeSignificanceMidTickRate(
+	TEXT("practice.Significance.MidTickRate"),
+	20.0f,
+	TEXT("Mid 단계의 초당 갱신 횟수"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPracticeSignificanceFarTickRate(
+	TEXT("practice.Significance.FarTickRate"),
+	5.0f,
+	TEXT("Far 단계의 초당 갱신 횟수"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPracticeSignificanceUpdateInterval(
+	TEXT("practice.Significance.UpdateInterval"),
+	0.25f,
+	TEXT("단계를 다시 계산하는 간격(초)"),
+	ECVF_Default);
+
+void UPracticeSignificanceSubsystem::Deinitialize()
+{
+	Pawns.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UPracticeSignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UPracticeSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPracticeSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void UPracticeSignificanceSubsystem::RegisterPawn(APracticeCharacter* Pawn)
+{
+	check(Pawn);
+	Pawns.AddUnique(Pawn);
+	// 다음 Tick에서 바로 단계를 결정한다.
+	TimeSinceUpdate = CVarPracticeSignificanceUpdateInterval.GetValueOnGameThread();
+}
+
+void UPracticeSignificanceSubsystem::UnregisterPawn(APracticeCharacter* Pawn)
+{
+	Pawns.RemoveSingleSwap(Pawn, EAllowShrinking::No);
+}
+
+float UPracticeSignificanceSubsystem::GetTickInterval(EPracticeSignificance Significance)
+{
+	float TickRate = 0.0f;
+	switch (Significance)
+	{
+	case EPracticeSignificance::Mid:
+		TickRate = CVarPracticeSignificanceMidTickRate.GetValueOnGameThread();
+		break;
+	case EPracticeSignificance::Far:
+		TickRate = CVarPracticeSignificanceFarTickRate.GetValueOnGameThread();
+		break;
+	case EPracticeSignificance::Near:
+	default:
+		break;
+	}
+	return TickRate > 0.0f ? 1.0f / TickRate : 0.0f;
+}
+
+void UPracticeSignificanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimeSinceUpdate += DeltaTime;
+	if (TimeSinceUpdate >= CVarPracticeSignificanceUpdateInterval.GetValueOnGameThread())
+	{
+		TimeSinceUpdate = 0.0f;
+		UpdateSignificance();
+	}
+
+	SET_DWORD_STAT(STAT_PracticeSignificanceNear, NumPawnsPerBucket[static_cast<int32>(EPracticeSignificance::Near)]);
+	SET_DWORD_STAT(STAT_PracticeSignificanceMid, NumPawnsPerBucket[static_cast<int32>(EPracticeSignificance::Mid)]);
+	SET_DWORD_STAT(STAT_PracticeSignificanceFar, NumPawnsPerBucket[static_cast<int32>(EPracticeSignificance::Far)]);
+}
+
+bool UPracticeSignificanceSubsystem::GetViewPoint(FVector& OutLocation, FVector& OutForward, float& OutHalfFOVCos, const APawn*& OutLocalPawn) const
+{
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (!PlayerController || !PlayerController->IsLocalController())
+	{
+		return false;
+	}
+
+	OutLocalPawn = PlayerController->GetPawn();
+
+	// 로컬 플레이어 Pawn의 카메라를 기준으로 한다. 없으면 Camera Manager를 사용한다.
+	const APracticeCharacter* LocalCharacter = Cast<APracticeCharacter>(OutLocalPawn);
+	if (const UCameraComponent* CameraComponent = LocalCharacter ? LocalCharacter->GetCameraComponent() : nullptr)
+	{
+		OutLocation = CameraComponent->GetComponentLocation();
+		OutForward = CameraComponent->GetForwardVector();
+		OutHalfFOVCos = FMath::Cos(FMath::DegreesToRadians(CameraComponent->FieldOfView * 0.5f));
+		return true;
+	}
+
+	if (const APlayerCameraManager* CameraManager = PlayerController->PlayerCameraManager)
+	{
+		OutLocation = CameraManager->GetCameraLocation();
+		OutForward = CameraManager->GetCameraRotation().Vector();
+		OutHalfFOVCos = FMath::Cos(FMath::DegreesToRadians(CameraManager->GetFOVAngle() * 0.5f));
+		return true;
+	}
+
+	return false;
+}
+
+void UPracticeSignificanceSubsystem::UpdateSignificance()
+{
+	FMemory::Memzero(NumPawnsPerBucket);
+
+	FVector ViewLocation;
+	FVector ViewForward;
+	float HalfFOVCos = 0.0f;
+	const APawn* LocalPawn = nullptr;
+	const bool bHasViewPoint = CVarPracticeSignificanceEnable.GetValueOnGameThread()
+		&& GetViewPoint(ViewLocation, ViewForward, HalfFOVCos, LocalPawn);
+
+	const float NearDistanceSquared = FMath::Square(CVarPracticeSignificanceNearDistance.GetValueOnGameThread());
+	const float MidDistanceSquared = FMath::Square(CVarPracticeSignificanceMidDistance.GetValueOnGameThread());
+
+	for (APracticeCharacter* Pawn : Pawns)
+	{
+		EPracticeSignificance NewSignificance = EPracticeSignificance::Near;
+		// 플레이어가 조종하는 Pawn은 네트워크 예측 결과와 맞아야 하므로 항상 전체 이동을 사용한다.
+		if (bHasViewPoint && Pawn != LocalPawn && !Pawn->IsPlayerControlled())
+		{
+			const FVector ToPawn = Pawn->GetActorLocation() - ViewLocation;
+			const float DistanceSquared = ToPawn.SizeSquared();
+			if (DistanceSquared > MidDistanceSquared)
+			{
+				NewSignificance = EPracticeSignificance::Far;
+			}
+			else if (DistanceSquared > NearDistanceSquared)
+			{
+				NewSignificance = EPracticeSignificance::Mid;
+			}
+
+			// 시야 밖이면 한 단계 낮춘다. 시야각은 가로 기준이라 대략적인 판정이다.
+			const bool bInView = FVector::DotProduct(ToPawn.GetSafeNormal(), ViewForward) >= HalfFOVCos;
+			if (!bInView && NewSignificance != EPracticeSignificance::Far)
+			{
+				NewSignificance = static_cast<EPracticeSignificance>(static_cast<uint8>(NewSignificance) + 1);
+			}
+		}
+
+		++NumPawnsPerBucket[static_cast<int32>(NewSignificance)];
+		if (NewSignificance != Pawn->GetSignificance())
+		{
+			Pawn->SetSignificance(NewSignificance, GetTickInterval(NewSignificance));
+		}
+	}
+}
@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PracticeSpringArmComponent.h"
+
+#include "Engine/World.h"
+#include "PracticeMovementStats.h"
+
+DEFINE_STAT(STAT_PracticeSpringArmProbes);
+DEFINE_STAT(STAT_PracticeSpringArmProbesSkipped);
+
+UPracticeSpringArmComponent::UPracticeSpringArmComponent()
+{
+	ClearMargin = 10.0f;
+	MaxSkippedProbes = 10;
+}
+
+void UPracticeSpringArmComponent::UpdateArm(float DeltaTime)
+{
+	UpdateDesiredArmLocation(bDoCollisionTest, bEnableCameraLag, bEnableCameraRotationLag, DeltaTime);
+}
+
+void UPracticeSpringArmComponent::GetArmEnds(FVector& OutOrigin, FVector& OutEnd) const
+{
+	// USpringArmComponent::UpdateDesiredArmLocation과 같은 계산
+	const FRotator DesiredRotation = GetTargetRotation();
+	OutOrigin = GetComponentLocation() + TargetOffset;
+	OutEnd = OutOrigin - DesiredRotation.Vector() * TargetArmLength + FRotationMatrix(DesiredRotation).TransformVector(SocketOffset);
+}
+
+void UPracticeSpringArmComponent::UpdateDesiredArmLocation(bool bDoTrace, bool bDoLocationLag, bool bDoRotationLag, float DeltaTime)
+{
+	if (!bDoTrace || bDoLocationLag || bDoRotationLag || ClearMargin <= 0.0f)
+	{
+		bHasClearArm = false;
+		bNearObstacle = false;
+		if (bDoTrace)
+		{
+			INC_DWORD_STAT(STAT_PracticeSpringArmProbes);
+		}
+		Super::UpdateDesiredArmLocation(bDoTrace, bDoLocationLag, bDoRotationLag, DeltaTime);
+		return;
+	}
+
+	FVector Origin, End;
+	GetArmEnds(Origin, End);
+
+	// 0. 가까이 막힌 곳이 있으면 MaxSkippedProbes 프레임 동안은 원래 크기로만 검사한다.
+	if (bNearObstacle && SkippedProbes < MaxSkippedProbes)
+	{
+		++SkippedProbes;
+		INC_DWORD_STAT(STAT_PracticeSpringArmProbes);
+		Super::UpdateDesiredArmLocation(true, false, false, DeltaTime);
+		return;
+	}
+
+	// 1. 이전 검사 영역 안에서 움직였으면 검사하지 않는다.
+	if (bHasClearArm && SkippedProbes < MaxSkippedProbes
+		&& FVector::DistSquared(Origin, ClearOrigin) <= FMath::Square(ClearMargin)
+		&& FVector::DistSquared(End, ClearEnd) <= FMath::Square(ClearMargin))
+	{
+		++SkippedProbes;
+		INC_DWORD_STAT(STAT_PracticeSpringArmProbesSkipped);
+		Super::UpdateDesiredArmLocation(false, false, false, DeltaTime);
+		return;
+	}
+
+	// 2. 여유를 둔 구로 검사해서 막혀 있지 않으면 검사 없이 Arm 길이를 그대로 사용한다.
+	INC_DWORD_STAT(STAT_PracticeSpringArmProbes);
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(PracticeSpringArm), false, GetOwner());
+	const bool bBlocked = GetWorld()->SweepTestByChannel(Origin, End, FQuat::Identity, ProbeChannel, FCollisionShape::MakeSphere(ProbeSize + ClearMargin), QueryParams);
+
+	bHasClearArm = !bBlocked;
+	bNearObstacle = bBlocked;
+	ClearOrigin = Origin;
+	ClearEnd = End;
+	SkippedProbes = 0;
+
+	if (!bBlocked)
+	{
+		Super::UpdateDesiredArmLocation(false, false, false, DeltaTime);
+		return;
+	}
+
+	// 3. 막혀 있거나 가까우면 원래 크기로 검사해서 Camera를 당긴다. 다음 프레임부터는 0.으로 처리한다.
+	INC_DWORD_STAT(STAT_PracticeSpringArmProbes);
+	Super::UpdateDesiredArmLocation(true, false, false, DeltaTime);
+}
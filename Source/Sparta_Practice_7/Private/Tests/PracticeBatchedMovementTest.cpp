@@ -0,0 +1,114 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "PracticeCharacter.h"
+#include "PracticeMovementSubsystem.h"
+#include "PracticeMovementTestWorld.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPracticeBatchedMovementTest, "Practice.Movement.Batched.MatchesActorTick",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+namespace PracticeBatchedMovementTest
+{
+	constexpr int32 NumPairs = 7;
+	constexpr int32 NumFrames = 240;
+	constexpr float DeltaTime = 1.0f / 60.0f;
+	// SIMD 계산은 float로 계산하므로 위치, 회전은 이 값(cm, 도) 안에서 같으면 된다.
+	constexpr double KernelTolerance = 0.1;
+
+	// 같은 쌍의 두 Pawn에 같은 입력을 넣는다. 쌍마다 이동 방향, 정지 구간, 점프 시점이 다르다.
+	void ApplyInput(APracticeCharacter* Pawn, int32 Pair, int32 Frame)
+	{
+		const float Angle = Pair * 0.9f + Frame * 0.03f;
+		Pawn->SetMoveInput((Frame / 40 + Pair) % 3 == 0 ? FVector2D::ZeroVector : FVector2D(FMath::Cos(Angle), FMath::Sin(Angle)));
+		Pawn->AddLookInput(FVector2D(0.25f * Pair, 0.0f));
+		if ((Frame + Pair * 5) % 37 == 0)
+		{
+			Pawn->RequestJump();
+		}
+	}
+
+	bool IsNearlyEqual(const FPracticeMovementSnapshot& A, const FPracticeMovementSnapshot& B, double Tolerance)
+	{
+		return A.MovementMode == B.MovementMode
+			&& A.Location.Equals(B.Location, Tolerance)
+			&& A.Rotation.Equals(B.Rotation, Tolerance)
+			&& A.ControlRotation.Equals(B.ControlRotation, Tolerance)
+			&& FMath::IsNearlyEqual(A.Velocity, B.Velocity, Tolerance)
+			&& A.MoveDirection.Equals(B.MoveDirection, Tolerance)
+			&& FMath::IsNearlyEqual(A.FallSpeed, B.FallSpeed, Tolerance)
+			&& FMath::IsNearlyEqual(A.StateTimeRemaining, B.StateTimeRemaining, UE_KINDA_SMALL_NUMBER)
+			&& FMemory::Memcmp(A.MovementTimers.Remaining, B.MovementTimers.Remaining, sizeof(A.MovementTimers.Remaining)) == 0;
+	}
+}
+
+// 같은 입력을 개별 Tick(TickMovement) 경로와 배치 이동 경로에 넣고 매 프레임 이동 상태를 비교한다.
+// Scalar 계산에서는 비트 단위로 같아야 하고, SIMD 계산에서는 KernelTolerance 안에서 같아야 한다.
+bool FPracticeBatchedMovementTest::RunTest(const FString& Parameters)
+{
+	using namespace PracticeBatchedMovementTest;
+
+	FPracticeScopedCVar SyncGroundProbe(TEXT("practice.GroundProbe.Async"), 0);
+
+	for (const int32 bUseKernels : { 0, 1 })
+	{
+		FPracticeScopedCVar SimdKernels(TEXT("practice.Movement.SimdKernels"), bUseKernels);
+		FPracticeMovementTestWorld TestWorld;
+		UPracticeMovementSubsystem* MovementSubsystem = TestWorld.GetWorld()->GetSubsystem<UPracticeMovementSubsystem>();
+		if (!TestNotNull(TEXT("Movement subsystem"), MovementSubsystem))
+		{
+			return false;
+		}
+
+		// 두 경로의 Pawn을 같은 위치에 둔다. Pawn끼리는 이동 Sweep에서 충돌하지 않는다.
+		// 짝수 쌍은 공중에서 시작해서 착지부터 확인한다.
+		TArray<APracticeCharacter*> ActorPawns;
+		TArray<APracticeCharacter*> BatchedPawns;
+		for (int32 Pair = 0; Pair < NumPairs; ++Pair)
+		{
+			const FVector FootLocation(Pair * 1000.0, 0.0, Pair % 2 == 0 ? 150.0 : 0.0);
+			ActorPawns.Add(TestWorld.SpawnPawn(FootLocation, false));
+			BatchedPawns.Add(TestWorld.SpawnPawn(FootLocation, true));
+		}
+		TestEqual(TEXT("Batched pawns"), MovementSubsystem->GetNumPawns(), NumPairs);
+
+		bool bMatched = true;
+		for (int32 Frame = 0; Frame < NumFrames && bMatched; ++Frame)
+		{
+			for (int32 Pair = 0; Pair < NumPairs; ++Pair)
+			{
+				ApplyInput(ActorPawns[Pair], Pair, Frame);
+				ApplyInput(BatchedPawns[Pair], Pair, Frame);
+			}
+
+			for (APracticeCharacter* Pawn : ActorPawns)
+			{
+				Pawn->TickMovement(DeltaTime);
+			}
+			MovementSubsystem->Tick(DeltaTime);
+
+			for (int32 Pair = 0; Pair < NumPairs && bMatched; ++Pair)
+			{
+				const FPracticeMovementSnapshot Expected = ActorPawns[Pair]->GetMovementSnapshot();
+				const FPracticeMovementSnapshot Actual = BatchedPawns[Pair]->GetMovementSnapshot();
+				bMatched = bUseKernels ? IsNearlyEqual(Actual, Expected, KernelTolerance) : Actual.IsBitwiseEqual(Expected);
+				if (!bMatched)
+				{
+					// 첫 번째 차이만 출력한다.
+					AddError(FString::Printf(TEXT("SimdKernels %d, frame %d, pair %d : batched %s %s (%s) / actor tick %s %s (%s)"),
+						bUseKernels, Frame, Pair,
+						*Actual.Location.ToString(), *Actual.Rotation.ToString(), *UEnum::GetValueAsString(Actual.MovementMode),
+						*Expected.Location.ToString(), *Expected.Rotation.ToString(), *UEnum::GetValueAsString(Expected.MovementMode)));
+				}
+			}
+		}
+	}
+
+	return !HasAnyErrors();
+}
+
+#endif
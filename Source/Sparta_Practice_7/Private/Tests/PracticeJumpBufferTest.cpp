@@ -0,0 +1,122 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "PracticeCharacter.h"
+#include "PracticeMovementSubsystem.h"
+#include "PracticeMovementTestWorld.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPracticeJumpBufferLandingTest, "Practice.Movement.JumpBuffer.PressBeforeLanding",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+namespace PracticeJumpBufferTest
+{
+	constexpr float DeltaTime = 1.0f / 60.0f;
+	constexpr int32 MaxFrames = 240;
+	constexpr double FallHeight = 150.0;
+
+	void TickPawn(UPracticeMovementSubsystem* MovementSubsystem, APracticeCharacter* Pawn)
+	{
+		if (Pawn->IsBatchedMovement())
+		{
+			MovementSubsystem->Tick(DeltaTime);
+		}
+		else
+		{
+			Pawn->TickMovement(DeltaTime);
+		}
+	}
+}
+
+// 공중에서 착지 한 프레임 전에 누른 점프는 Jump Buffer에 보관되었다가 착지 잠금이 끝날 때 점프해야 한다.
+// 먼저 입력 없이 떨어뜨려서 착지 프레임을 찾고, 같은 높이에서 떨어지는 다른 Pawn으로 그 전 프레임에 점프를 누른다.
+// JumpBufferTime이 0(기본값)이면 보관하지 않으므로 점프하지 않아야 한다.
+bool FPracticeJumpBufferLandingTest::RunTest(const FString& Parameters)
+{
+	using namespace PracticeJumpBufferTest;
+
+	FPracticeScopedCVar SyncGroundProbe(TEXT("practice.GroundProbe.Async"), 0);
+
+	struct FTestCase
+	{
+		bool bBatched;
+		float JumpBufferTime;
+		// 음수이면 기본값을 사용한다.
+		float LandingLockTime;
+	};
+	const FTestCase TestCases[] = {
+		{ false, 0.1f, -1.0f }, { true, 0.1f, -1.0f }, { false, 0.1f, 0.0f }, { true, 0.1f, 0.0f },
+		{ false, 0.0f, -1.0f }, { true, 0.0f, -1.0f } };
+
+	for (const FTestCase& TestCase : TestCases)
+	{
+		FPracticeMovementTestWorld TestWorld;
+		UPracticeMovementSubsystem* MovementSubsystem = TestWorld.GetWorld()->GetSubsystem<UPracticeMovementSubsystem>();
+		if (!TestNotNull(TEXT("Movement subsystem"), MovementSubsystem))
+		{
+			return false;
+		}
+
+		const FString What = FString::Printf(TEXT("Batched %d, JumpBufferTime %.2f, LandingLockTime %.2f"),
+			TestCase.bBatched, TestCase.JumpBufferTime, TestCase.LandingLockTime);
+
+		// 배치 이동은 등록할 때 값을 복사하므로 BeginPlay 전에 바꾼다.
+		const auto Setup = [&TestCase](APracticeCharacter* NewPawn)
+		{
+			NewPawn->JumpBufferTime = TestCase.JumpBufferTime;
+			if (TestCase.LandingLockTime >= 0.0f)
+			{
+				NewPawn->LandingLockTime = TestCase.LandingLockTime;
+			}
+		};
+
+		APracticeCharacter* Reference = TestWorld.SpawnPawn(FVector(0.0, 0.0, FallHeight), TestCase.bBatched, Setup);
+
+		// 착지 프레임
+		int32 LandFrame = INDEX_NONE;
+		for (int32 Frame = 0; Frame < MaxFrames && LandFrame == INDEX_NONE; ++Frame)
+		{
+			TickPawn(MovementSubsystem, Reference);
+			if (PracticeMovement::IsGroundMode(Reference->GetMovementMode()))
+			{
+				LandFrame = Frame;
+			}
+		}
+		if (!TestTrue(*FString::Printf(TEXT("%s : reference pawn lands"), *What), LandFrame > 0))
+		{
+			continue;
+		}
+
+		// 배치 이동은 Subsystem Tick에서 모든 Pawn이 움직이므로 기준 Pawn이 착지한 뒤에 만든다.
+		APracticeCharacter* Pawn = TestWorld.SpawnPawn(FVector(1000.0, 0.0, FallHeight), TestCase.bBatched, Setup);
+
+		// 착지 잠금이 끝나는 프레임까지 기다린다.
+		const int32 LockFrames = FMath::CeilToInt(Pawn->LandingLockTime / DeltaTime);
+		bool bJumped = false;
+		for (int32 Frame = 0; Frame <= LandFrame + LockFrames && !bJumped; ++Frame)
+		{
+			if (Frame == LandFrame - 1)
+			{
+				TestTrue(*FString::Printf(TEXT("%s : pawn is falling when jump is pressed"), *What), Pawn->GetMovementMode() == EPracticeMovementMode::Falling);
+				Pawn->RequestJump();
+			}
+			TickPawn(MovementSubsystem, Pawn);
+			bJumped = Pawn->GetMovementMode() == EPracticeMovementMode::Jumping && Frame >= LandFrame;
+		}
+		if (TestCase.JumpBufferTime > 0.0f)
+		{
+			TestTrue(*FString::Printf(TEXT("%s : jump pressed one frame before landing is replayed"), *What), bJumped);
+		}
+		else
+		{
+			TestFalse(*FString::Printf(TEXT("%s : jump pressed one frame before landing is dropped"), *What), bJumped);
+		}
+	}
+
+	return !HasAnyErrors();
+}
+
+#endif
@@ -0,0 +1,106 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "PracticeCharacter.h"
+#include "PracticeMovementSubsystem.h"
+#include "PracticeMovementTestWorld.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPracticeMovementBaseTest, "Practice.Movement.Base.FollowAndRelease",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+namespace PracticeMovementBaseTest
+{
+	constexpr float DeltaTime = 1.0f / 60.0f;
+	constexpr int32 MaxFrames = 240;
+	// 발판 윗면 높이
+	constexpr double BaseTop = 100.0;
+
+	void TickPawn(UPracticeMovementSubsystem* MovementSubsystem, APracticeCharacter* Pawn)
+	{
+		if (Pawn->IsBatchedMovement())
+		{
+			MovementSubsystem->Tick(DeltaTime);
+		}
+		else
+		{
+			Pawn->TickMovement(DeltaTime);
+		}
+	}
+
+	// 바닥 위에 떠 있는 움직일 수 있는 BlockAll Box 발판을 만든다.
+	UBoxComponent* SpawnBase(UWorld* World)
+	{
+		AActor* BaseActor = World->SpawnActor<AActor>();
+		UBoxComponent* BaseBox = NewObject<UBoxComponent>(BaseActor, TEXT("Base"));
+		BaseBox->SetBoxExtent(FVector(200.0, 200.0, 10.0));
+		BaseBox->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+		BaseBox->SetMobility(EComponentMobility::Movable);
+		BaseBox->SetWorldLocation(FVector(0.0, 0.0, BaseTop - 10.0));
+		BaseActor->SetRootComponent(BaseBox);
+		BaseBox->RegisterComponent();
+		return BaseBox;
+	}
+}
+
+// 발판에 착지한 Pawn은 발판을 Base로 기록하고 발판이 움직이면 같이 움직여야 한다.
+// 발판이 없어지면 Base에서 내려지고 깨어나야 한다.
+bool FPracticeMovementBaseTest::RunTest(const FString& Parameters)
+{
+	using namespace PracticeMovementBaseTest;
+
+	FPracticeScopedCVar SyncGroundProbe(TEXT("practice.GroundProbe.Async"), 0);
+
+	for (const bool bBatched : { false, true })
+	{
+		FPracticeMovementTestWorld TestWorld;
+		UPracticeMovementSubsystem* MovementSubsystem = TestWorld.GetWorld()->GetSubsystem<UPracticeMovementSubsystem>();
+		if (!TestNotNull(TEXT("Movement subsystem"), MovementSubsystem))
+		{
+			return false;
+		}
+
+		const FString What = FString::Printf(TEXT("Batched %d"), bBatched);
+
+		UBoxComponent* BaseBox = SpawnBase(TestWorld.GetWorld());
+		APracticeCharacter* Pawn = TestWorld.SpawnPawn(FVector(0.0, 0.0, BaseTop + 50.0), bBatched);
+
+		for (int32 Frame = 0; Frame < MaxFrames && !PracticeMovement::IsGroundMode(Pawn->GetMovementMode()); ++Frame)
+		{
+			TickPawn(MovementSubsystem, Pawn);
+		}
+		if (!TestTrue(*FString::Printf(TEXT("%s : pawn lands on the base"), *What), Pawn->GetMovementBase() == BaseBox))
+		{
+			continue;
+		}
+
+		// 발판을 옮기면 TransformUpdated에서 바로 같이 옮긴다.
+		const FVector Offset(150.0, -100.0, 0.0);
+		const FVector StartLocation = Pawn->GetActorLocation();
+		BaseBox->SetWorldLocation(BaseBox->GetComponentLocation() + Offset);
+		TestTrue(*FString::Printf(TEXT("%s : pawn follows the base"), *What), Pawn->GetActorLocation().Equals(StartLocation + Offset, 0.1));
+
+		// 옮긴 뒤에도 이동이 발판 위에서 이어지고 Base가 유지된다.
+		TickPawn(MovementSubsystem, Pawn);
+		TestTrue(*FString::Printf(TEXT("%s : pawn keeps the base after moving with it"), *What), Pawn->GetMovementBase() == BaseBox);
+
+		// 발판을 없애면 물리 상태가 없어지면서 Base에서 내린다.
+		BaseBox->GetOwner()->Destroy();
+		TestTrue(*FString::Printf(TEXT("%s : pawn is released when the base is destroyed"), *What), Pawn->GetMovementBase() == nullptr);
+		TestFalse(*FString::Printf(TEXT("%s : released pawn is awake"), *What), Pawn->IsSleeping());
+
+		// 설 곳이 없으므로 바닥까지 떨어진다.
+		for (int32 Frame = 0; Frame < MaxFrames && Pawn->GetActorLocation().Z - Pawn->GetSimpleCollisionHalfHeight() > 1.0; ++Frame)
+		{
+			TickPawn(MovementSubsystem, Pawn);
+		}
+		TestTrue(*FString::Printf(TEXT("%s : released pawn falls to the floor"), *What), Pawn->GetActorLocation().Z - Pawn->GetSimpleCollisionHalfHeight() <= 1.0);
+	}
+
+	return !HasAnyErrors();
+}
+
+#endif
@@ -0,0 +1,161 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "PracticeMovementKernels.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPracticeKernelCalculateVelocityTest, "Practice.Movement.Kernels.CalculateVelocity",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPracticeKernelUpdateFallSpeedTest, "Practice.Movement.Kernels.UpdateFallSpeed",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPracticeKernelClampAirSpeedTest, "Practice.Movement.Kernels.ClampAirSpeed",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// SIMD 계산 결과를 PracticeMovement의 Scalar 함수 결과와 비교한다.
+// Lane 수는 LaneWidth의 배수가 아니므로 앞의 8 Lane은 SIMD로, 마지막 3 Lane은 Scalar로 처리된다.
+// 비활성 Lane은 원래 값을 유지해야 한다.
+namespace PracticeMovementKernelsTest
+{
+	constexpr int32 NumLanes = 11;
+	static_assert(NumLanes % PracticeMovementKernels::LaneWidth != 0, "Tail lanes must be covered");
+
+	// UPracticeMovementSubsystem의 practice.Movement.ValidateKernels와 같은 상대 허용 오차
+	constexpr float Tolerance = 1.e-4f;
+
+	constexpr float FrameTime = 1.0f / 60.0f;
+
+	bool IsNearlyEqual(const double Actual, const double Expected)
+	{
+		return FMath::IsNearlyEqual(Actual, Expected, Tolerance * FMath::Max(1.0, FMath::Abs(Expected)));
+	}
+
+	void TestLanes(FAutomationTestBase& Test, const TCHAR* What, const float* Actual, const float* Expected)
+	{
+		for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+		{
+			if (!IsNearlyEqual(Actual[Lane], Expected[Lane]))
+			{
+				Test.AddError(FString::Printf(TEXT("%s [%d] : kernel %f, scalar %f"), What, Lane, Actual[Lane], Expected[Lane]));
+			}
+		}
+	}
+}
+
+bool FPracticeKernelCalculateVelocityTest::RunTest(const FString& Parameters)
+{
+	using namespace PracticeMovementKernelsTest;
+
+	//							가속		지상 아님	목표 속도	거의 같음	DeltaTime 0	Alpha 1		지상 아님	감속		가속		Damp 0		지상 아님
+	float Velocity[]		= { 0.0f,		300.0f,		600.0f,		5.e-9f,		200.0f,		450.0f,		100.0f,		600.0f,		0.0f,		320.0f,		50.0f };
+	const float Target[]	= { 600.0f,		0.0f,		600.0f,		0.0f,		600.0f,		0.0f,		600.0f,		0.0f,		600.0f,		600.0f,		0.0f };
+	const float AccelDamp[]	= { 20.0f,		20.0f,		20.0f,		20.0f,		20.0f,		20.0f,		20.0f,		20.0f,		20.0f,		0.0f,		20.0f };
+	const float DeltaTime[]	= { FrameTime,	FrameTime,	FrameTime,	FrameTime,	0.0f,		0.1f,		FrameTime,	FrameTime * 2.0f,	FrameTime,	FrameTime,	FrameTime };
+	const float Ground[]	= { 1.0f,		0.0f,		1.0f,		1.0f,		1.0f,		1.0f,		0.0f,		1.0f,		1.0f,		1.0f,		0.0f };
+	static_assert(UE_ARRAY_COUNT(Velocity) == NumLanes, "");
+
+	float Expected[NumLanes];
+	for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+	{
+		Expected[Lane] = Ground[Lane] > 0.0f
+			? PracticeMovement::CalculateVelocity(Velocity[Lane], Target[Lane], AccelDamp[Lane], DeltaTime[Lane])
+			: Velocity[Lane];
+	}
+
+	PracticeMovementKernels::CalculateVelocity(Velocity, Target, AccelDamp, DeltaTime, Ground, NumLanes);
+	TestLanes(*this, TEXT("Velocity"), Velocity, Expected);
+
+	return !HasAnyErrors();
+}
+
+bool FPracticeKernelUpdateFallSpeedTest::RunTest(const FString& Parameters)
+{
+	using namespace PracticeMovementKernelsTest;
+
+	//								지상		상승		종단 속도	종단 제한	종단 이하	DeltaTime 0	비활성		DeltaTime 0	0을 지남	종단 제한	지상
+	float FallSpeed[]			= { 123.0f,		500.0f,		-2500.0f,	-2490.0f,	-3000.0f,	0.0f,		-100.0f,	-50.0f,		10.0f,		-2499.0f,	77.0f };
+	const float DeltaTime[]		= { FrameTime,	FrameTime,	FrameTime,	FrameTime,	FrameTime,	0.0f,		FrameTime,	0.0f,		FrameTime,	FrameTime,	0.0f };
+	const float Ground[]		= { 1.0f,		0.0f,		0.0f,		0.0f,		0.0f,		0.0f,		0.0f,		0.0f,		0.0f,		0.0f,		1.0f };
+	const float Air[]			= { 0.0f,		1.0f,		1.0f,		1.0f,		1.0f,		1.0f,		0.0f,		1.0f,		1.0f,		1.0f,		0.0f };
+	static_assert(UE_ARRAY_COUNT(FallSpeed) == NumLanes, "");
+
+	float Gravity[NumLanes];
+	float FallMultiplier[NumLanes];
+	float TerminalSpeed[NumLanes];
+	float Expected[NumLanes];
+	const FPracticeMovementParams Params;
+	for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+	{
+		Gravity[Lane] = Params.Gravity;
+		FallMultiplier[Lane] = Params.FallMultiplier;
+		TerminalSpeed[Lane] = Params.TerminalSpeed;
+
+		// 지상 Lane은 낙하 속도 0에서 시작한다.
+		if (Ground[Lane] > 0.0f)
+		{
+			Expected[Lane] = PracticeMovement::UpdateFallSpeed(0.0f, Params, DeltaTime[Lane]);
+		}
+		else if (Air[Lane] > 0.0f)
+		{
+			Expected[Lane] = PracticeMovement::UpdateFallSpeed(FallSpeed[Lane], Params, DeltaTime[Lane]);
+		}
+		else
+		{
+			Expected[Lane] = FallSpeed[Lane];
+		}
+	}
+	TestEqual(TEXT("Terminal speed lane stays at terminal speed"), Expected[2], Params.TerminalSpeed);
+	TestEqual(TEXT("Terminal clamp lane is clamped"), Expected[3], Params.TerminalSpeed);
+
+	PracticeMovementKernels::UpdateFallSpeed(FallSpeed, Gravity, FallMultiplier, TerminalSpeed, DeltaTime, Ground, Air, NumLanes);
+	TestLanes(*this, TEXT("FallSpeed"), FallSpeed, Expected);
+
+	return !HasAnyErrors();
+}
+
+bool FPracticeKernelClampAirSpeedTest::RunTest(const FString& Parameters)
+{
+	using namespace PracticeMovementKernelsTest;
+
+	//							최대 초과	최대 이하	최대와 같음	0			비활성		아주 작음	최대 초과	수직		최대 이하	최대와 같음	비활성
+	float Velocity[]		= { 0.0f,		0.0f,		0.0f,		0.0f,		250.0f,		0.0f,		0.0f,		0.0f,		0.0f,		0.0f,		40.0f };
+	float SpeedX[]			= { 700.0f,		300.0f,		360.0f,		0.0f,		1.0f,		1.e-5f,		-600.0f,	0.0f,		100.0f,		600.0f,		5.0f };
+	float SpeedY[]			= { 0.0f,		400.0f,		480.0f,		0.0f,		2.0f,		0.0f,		600.0f,		0.0f,		0.0f,		0.0f,		5.0f };
+	float SpeedZ[]			= { 0.0f,		0.0f,		0.0f,		0.0f,		3.0f,		0.0f,		0.0f,		-900.0f,	50.0f,		0.0f,		5.0f };
+	const float Air[]		= { 1.0f,		1.0f,		1.0f,		1.0f,		0.0f,		1.0f,		1.0f,		1.0f,		1.0f,		1.0f,		0.0f };
+	static_assert(UE_ARRAY_COUNT(Velocity) == NumLanes, "");
+
+	float MaxSpeed[NumLanes];
+	float ExpectedVelocity[NumLanes];
+	float ExpectedX[NumLanes];
+	float ExpectedY[NumLanes];
+	float ExpectedZ[NumLanes];
+	for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+	{
+		MaxSpeed[Lane] = 600.0f;
+
+		ExpectedVelocity[Lane] = Velocity[Lane];
+		FVector ExpectedDirection(SpeedX[Lane], SpeedY[Lane], SpeedZ[Lane]);
+		if (Air[Lane] > 0.0f)
+		{
+			PracticeMovement::ClampAirSpeed(FVector(SpeedX[Lane], SpeedY[Lane], SpeedZ[Lane]), MaxSpeed[Lane], ExpectedVelocity[Lane], ExpectedDirection);
+		}
+		ExpectedX[Lane] = ExpectedDirection.X;
+		ExpectedY[Lane] = ExpectedDirection.Y;
+		ExpectedZ[Lane] = ExpectedDirection.Z;
+	}
+	TestEqual(TEXT("Clamp lane is clamped"), ExpectedVelocity[0], MaxSpeed[0]);
+	TestTrue(TEXT("Max speed lane is unchanged"), FMath::IsNearlyEqual(ExpectedVelocity[2], MaxSpeed[2], Tolerance));
+
+	PracticeMovementKernels::ClampAirSpeed(Velocity, SpeedX, SpeedY, SpeedZ, MaxSpeed, Air, NumLanes);
+	TestLanes(*this, TEXT("Velocity"), Velocity, ExpectedVelocity);
+	TestLanes(*this, TEXT("Direction X"), SpeedX, ExpectedX);
+	TestLanes(*this, TEXT("Direction Y"), SpeedY, ExpectedY);
+	TestLanes(*this, TEXT("Direction Z"), SpeedZ, ExpectedZ);
+
+	return !HasAnyErrors();
+}
+
+#endif
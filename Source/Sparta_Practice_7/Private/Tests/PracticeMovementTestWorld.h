@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AIController.h"
+#include "Components/BoxComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/IConsoleManager.h"
+#include "PracticeCharacter.h"
+
+// 테스트 동안 CVar 값을 바꾸고 끝나면 이전 값으로 되돌린다.
+class FPracticeScopedCVar
+{
+public:
+	FPracticeScopedCVar(const TCHAR* Name, int32 Value)
+		: CVar(IConsoleManager::Get().FindConsoleVariable(Name))
+	{
+		if (CVar)
+		{
+			PrevValue = CVar->GetString();
+			CVar->Set(Value, ECVF_SetByCode);
+		}
+	}
+
+	~FPracticeScopedCVar()
+	{
+		if (CVar)
+		{
+			CVar->Set(*PrevValue, ECVF_SetByCode);
+		}
+	}
+
+private:
+	IConsoleVariable* CVar = nullptr;
+	FString PrevValue;
+};
+
+/**
+ * 이동 자동화 테스트에서 사용하는 Game World
+ * 윗면이 Z = 0인 넓은 바닥만 있다. World Tick 없이 테스트에서 TickMovement나 Subsystem Tick을 직접 호출한다.
+ * 비동기 지면 Probe는 World Tick이 있어야 결과가 나오므로 practice.GroundProbe.Async를 0으로 두고 사용한다.
+ */
+class FPracticeMovementTestWorld
+{
+public:
+	FPracticeMovementTestWorld()
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false);
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+		World->InitializeActorsForPlay(FURL());
+
+		// Asset 없이 BlockAll Box로 바닥을 만든다.
+		AActor* Floor = World->SpawnActor<AActor>();
+		UBoxComponent* FloorBox = NewObject<UBoxComponent>(Floor, TEXT("Floor"));
+		FloorBox->SetBoxExtent(FVector(100000.0, 100000.0, 50.0));
+		FloorBox->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+		FloorBox->SetMobility(EComponentMobility::Static);
+		FloorBox->SetWorldLocation(FVector(0.0, 0.0, -50.0));
+		Floor->SetRootComponent(FloorBox);
+		FloorBox->RegisterComponent();
+
+		// GameMode 없이 이후에 만드는 Actor까지 BeginPlay를 호출한다.
+		// World BeginPlay는 호출하지 않으므로 지면 높이 캐시는 사용하지 않는다.
+		World->GetWorldSettings()->NotifyBeginPlay();
+	}
+
+	~FPracticeMovementTestWorld()
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+	UWorld* GetWorld() const { return World; }
+
+	// 발 위치(Capsule 아래쪽)에 Pawn을 만들고 AIController로 조종한다.
+	// bBatched가 false이면 외부 진행으로 바꿔서 TickMovement 호출로만 움직인다.
+	// 배치 이동은 등록할 때 튜닝 값을 복사하므로 튜닝 값은 BeginPlay 전에 호출되는 Setup에서 바꾼다.
+	APracticeCharacter* SpawnPawn(const FVector& FootLocation, bool bBatched, TFunctionRef<void(APracticeCharacter*)> Setup = [](APracticeCharacter*) {})
+	{
+		APracticeCharacter* Pawn = World->SpawnActorDeferred<APracticeCharacter>(APracticeCharacter::StaticClass(), FTransform::Identity,
+			nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		Pawn->bUseBatchedMovement = bBatched;
+		Setup(Pawn);
+		const UCapsuleComponent* Capsule = CastChecked<UCapsuleComponent>(Pawn->GetRootComponent());
+		Pawn->FinishSpawning(FTransform(FootLocation + FVector(0.0, 0.0, Capsule->GetScaledCapsuleHalfHeight())));
+
+		AAIController* AIController = World->SpawnActor<AAIController>();
+		AIController->Possess(Pawn);
+		if (!bBatched)
+		{
+			Pawn->SetExternalStepping(true);
+		}
+		return Pawn;
+	}
+
+private:
+	UWorld* World = nullptr;
+};
+
+#endif
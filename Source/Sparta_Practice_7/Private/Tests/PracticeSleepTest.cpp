@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "PracticeCharacter.h"
+#include "PracticeMovementTestWorld.h"
+#include "PracticeSeparationSubsystem.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPracticeSleepTest, "Practice.Movement.Sleep.SleepAndWake",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+namespace PracticeSleepTest
+{
+	constexpr float DeltaTime = 1.0f / 60.0f;
+	constexpr int32 MaxFrames = 240;
+
+	// Sleep은 Actor Tick에서만 판단하므로 World Tick 대신 Tick을 직접 호출한다.
+	bool TickUntilSleeping(APracticeCharacter* Pawn)
+	{
+		for (int32 Frame = 0; Frame < MaxFrames && !Pawn->IsSleeping(); ++Frame)
+		{
+			Pawn->Tick(DeltaTime);
+		}
+		return Pawn->IsSleeping();
+	}
+}
+
+// 지면에 서 있는 Pawn은 SleepDelay 뒤에 Tick을 끄고, 이동 입력과 다른 Pawn의 밀어내기에서 깨어나야 한다.
+bool FPracticeSleepTest::RunTest(const FString& Parameters)
+{
+	using namespace PracticeSleepTest;
+
+	FPracticeScopedCVar SyncGroundProbe(TEXT("practice.GroundProbe.Async"), 0);
+	FPracticeScopedCVar EnableSleep(TEXT("practice.Sleep.Enable"), 1);
+	FPracticeScopedCVar EnableSeparation(TEXT("practice.Separation.Enable"), 1);
+
+	FPracticeMovementTestWorld TestWorld;
+	UPracticeSeparationSubsystem* SeparationSubsystem = TestWorld.GetWorld()->GetSubsystem<UPracticeSeparationSubsystem>();
+	if (!TestNotNull(TEXT("Separation subsystem"), SeparationSubsystem))
+	{
+		return false;
+	}
+
+	// 외부 Stepping에서는 Sleep하지 않으므로 개별 Tick으로 되돌린다.
+	const auto Setup = [](APracticeCharacter* NewPawn)
+	{
+		NewPawn->bCanSleep = true;
+		NewPawn->SleepDelay = 0.25f;
+	};
+	APracticeCharacter* Pawn = TestWorld.SpawnPawn(FVector::ZeroVector, false, Setup);
+	Pawn->SetExternalStepping(false);
+
+	// Capsule은 겹치지 않고 밀어내기 거리(반지름 합 + Padding) 안에 있는 Pawn
+	// 밀어내기 Subsystem을 Tick하기 전에는 밀어내지 않는다.
+	const double Distance = Pawn->GetSimpleCollisionRadius() * 2.0 + 5.0;
+	TestWorld.SpawnPawn(FVector(Distance, 0.0, 0.0), false, Setup);
+
+	// 1. 정지
+	if (!TestTrue(TEXT("idle pawn falls asleep"), TickUntilSleeping(Pawn)))
+	{
+		return false;
+	}
+	TestFalse(TEXT("sleeping pawn disables actor tick"), Pawn->IsActorTickEnabled());
+
+	// 2. 이동 입력
+	Pawn->SetMoveInput(FVector2D(1.0f, 0.0f));
+	TestFalse(TEXT("move input wakes the pawn"), Pawn->IsSleeping());
+	TestTrue(TEXT("woken pawn enables actor tick"), Pawn->IsActorTickEnabled());
+
+	Pawn->SetMoveInput(FVector2D::ZeroVector);
+	if (!TestTrue(TEXT("pawn falls asleep again after input stops"), TickUntilSleeping(Pawn)))
+	{
+		return false;
+	}
+
+	// 3. 밀어내기
+	SeparationSubsystem->Tick(DeltaTime);
+	TestFalse(TEXT("separation push wakes the pawn"), Pawn->IsSleeping());
+
+	return !HasAnyErrors();
+}
+
+#endif
@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIController.h"
+#include "PracticeAIController.generated.h"
+
+class APracticeCharacter;
+
+UENUM(BlueprintType)
+enum class EPracticeAIBehavior : uint8
+{
+	// 입력을 넣지 않는다. 벤치마크처럼 외부에서 입력을 넣을 때 사용한다.
+	Idle,
+	// 시작 위치 주변의 임의의 위치로 이동을 반복한다.
+	Wander,
+	// PathPoints를 순서대로 따라간다.
+	FollowPath,
+};
+
+/**
+ * APracticeCharacter를 움직이는 AI
+ * Enhanced Input을 거치지 않고 플레이어 입력과 같은 경로(Controller Yaw, SetMoveInput, RequestJump)로 이동을 지시한다.
+ * 이동 방향은 DecisionInterval마다 한 번 정하고 그 사이에는 같은 입력을 유지한다.
+ *
+ * 콘솔 명령
+ * practice.SpawnAI <수> [Wander|Path] [반경]	: 플레이어 주변에 AI Pawn을 만든다. APracticeGameMode면 Pawn Pool을 사용한다.
+ * practice.ClearAI								: practice.SpawnAI로 만든 AI Pawn을 모두 제거한다.
+ */
+UCLASS()
+class SPARTA_PRACTICE_7_API APracticeAIController : public AAIController
+{
+	GENERATED_BODY()
+
+public:
+	APracticeAIController();
+
+	virtual void Tick(float DeltaTime) override;
+
+	void StartWander(const FVector& Origin, float Radius);
+	void StartFollowPath(const TArray<FVector>& Points, bool bLoop);
+	void StopBehavior();
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
+	EPracticeAIBehavior Behavior;
+
+	// 시작 위치 기준 배회 반경
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI|Wander")
+	float WanderRadius;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI|Path")
+	TArray<FVector> PathPoints;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI|Path")
+	bool bLoopPath;
+
+	// 목표와 이 거리(수평) 안으로 들어오면 도착으로 본다.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
+	float AcceptanceRadius;
+
+	// 목표에 이 시간 안에 도착하지 못하면 막힌 것으로 보고 다음 목표로 넘어간다.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
+	float TargetTimeout;
+
+	// 이동 방향을 다시 정하는 간격
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI", meta = (ClampMin = "0.0"))
+	float DecisionInterval;
+
+	// 평균 점프 간격(초), 0이면 점프하지 않는다.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
+	float JumpInterval;
+
+	// 콘솔 명령
+	static void SpawnAIPawns(const TArray<FString>& Args, UWorld* World);
+	static void ClearAIPawns(UWorld* World);
+
+protected:
+	virtual void OnPossess(APawn* InPawn) override;
+	virtual void OnUnPossess() override;
+
+private:
+	void Decide();
+	// 다음 목표를 정한다. 목표가 없으면 false
+	bool PickNextTarget();
+	float GetRandomJumpDelay();
+
+	FVector HomeLocation = FVector::ZeroVector;
+	FVector TargetLocation = FVector::ZeroVector;
+	bool bHasTarget = false;
+	int32 PathIndex = 0;
+	float DecisionTimeRemaining = 0.0f;
+	float TargetTimeRemaining = 0.0f;
+	float JumpTimeRemaining = 0.0f;
+	FRandomStream Random;
+
+	// practice.SpawnAI로 만든 Pawn, practice.ClearAI에서 제거한다.
+	bool bSpawnedByCommand = false;
+};
@@ -0,0 +1,21 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Camera/PlayerCameraManager.h"
+#include "PracticeCameraManager.generated.h"
+
+/**
+ * APracticeController의 Camera Manager
+ * Camera Manager는 모든 Actor Tick, 물리, Tickable(배치 이동 포함)이 끝난 뒤에 갱신되므로
+ * APracticeCharacter의 Camera 회전과 Spring Arm을 여기에서 프레임에 한 번 갱신한다. (practice.Camera.LateUpdate)
+ */
+UCLASS()
+class SPARTA_PRACTICE_7_API APracticeCameraManager : public APlayerCameraManager
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime) override;
+};
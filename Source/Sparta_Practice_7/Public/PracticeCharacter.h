@@ -4,6 +4,9 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Curves/CurveFloat.h"
+#include "PracticeMovementTypes.h"
+#include "PracticeNetMovement.h"
 #include "PracticeCharacter.generated.h"
 
 struct FInputActionValue;
@@ -13,6 +16,10 @@ UCLASS()
 class SPARTA_PRACTICE_7_API APracticeCharacter : public APawn
 {
 	GENERATED_BODY()
+
+	friend class UPracticeMovementSubsystem;
+	friend class UPracticeSeparationSubsystem;
+	friend class UPracticeMovementBaseSubsystem;
 	
 public:	
 	// Sets default values for this actor's properties
@@ -21,6 +28,7 @@ public:
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Character")
 	TObjectPtr<class UCapsuleComponent> CapsuleComponent;
@@ -29,7 +37,7 @@ protected:
 	TObjectPtr<class USkeletalMeshComponent> MeshComponent;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Character")
-	TObjectPtr<class USpringArmComponent> SpringArmComponent;
+	TObjectPtr<class UPracticeSpringArmComponent> SpringArmComponent;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Character")
 	TObjectPtr<class UCameraComponent> CameraComponent;
@@ -48,8 +56,118 @@ protected:
 
 	// 이동 입력 방향(정규화되어 있다.)
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement")
-	FVector2D InputDirection;	
-	
+	FVector2D InputDirection;
+
+public:
+	// 입력 장치 없이 이동을 지시할 때 사용한다. (벤치마크, AI 등)
+	// 배치 이동 중이면 Subsystem에 전달한다.
+	void SetMoveInput(const FVector2D& NewInputDirection);
+	void RequestJump();
+	void RequestToggleDrone();
+	void SetDroneThrustInput(float NewThrustInput);
+	// 마우스 이동량(X : Yaw, Y : Pitch), 다음 UpdateControllerRotation까지 더해 둔다.
+	void AddLookInput(const FVector2D& LookDelta);
+
+	FVector2D GetInputDirection() const { return InputDirection; }
+	float GetDroneThrustInput() const { return DroneThrustInput; }
+
+	// 이번 프레임에 들어온 버튼 입력(EPracticeInputButtons), Tick이 끝나면 초기화된다.
+	uint8 GetPendingInputButtons() const { return PendingInputButtons; }
+
+	// 입력 재생 : 현재 이동 상태를 가져오거나 덮어쓴다.
+	FPracticeMovementSnapshot GetMovementSnapshot() const;
+	void ApplyMovementSnapshot(const FPracticeMovementSnapshot& Snapshot);
+
+	// 외부(입력 재생 등)에서 DeltaTime을 정해서 이동을 진행한다.
+	// 켜면 개별 Tick과 배치 이동을 사용하지 않고 TickMovement 호출로만 움직인다. 끄면 bUseBatchedMovement에 따라 다시 등록한다.
+	void SetExternalStepping(bool bEnable);
+	void TickMovement(float DeltaTime);
+
+private:
+	uint8 PendingInputButtons = 0;
+
+public:
+	// 풀링 : APracticeGameMode의 Pawn Pool에서 사용한다.
+	// 풀에 들어간 Pawn은 Component를 유지한 채로 숨기고 Tick, 충돌, 이동 Subsystem 등록을 끈다.
+	void DeactivateForPool(const FVector& ParkingLocation);
+	void ActivateFromPool(const FTransform& SpawnTransform);
+	bool IsPooled() const { return bIsPooled; }
+
+	// 이동 상태를 처음 상태로 되돌린다. 튜닝 값은 유지한다.
+	void ResetMovementState();
+
+private:
+	// 배치 이동, 지면 검사, Significance, 밀어내기 Subsystem 등록
+	void RegisterMovement();
+	void UnregisterMovement();
+	// bUseBatchedMovement이고 등록되지 않았으면 배치 이동 Subsystem에 등록한다.
+	void RegisterBatchedMovement();
+
+	// UPracticeSeparationSubsystem의 Index, 등록되지 않았으면 INDEX_NONE
+	int32 SeparationIndex = INDEX_NONE;
+
+	bool bIsPooled = false;
+
+public:
+	// 네트워크 이동 (서버 권한)
+	// 1. 클라이언트(Autonomous Proxy)는 입력을 양자화해서 그 값으로 바로 예측 이동하고, 같은 입력을 ServerMove로 보낸다.
+	// 2. 서버는 같은 입력으로 이동한 결과를 클라이언트 위치와 비교해서 차이가 크면 ClientAdjustPosition으로 서버 상태를 보낸다.
+	// 3. 클라이언트는 서버 상태를 적용하고 서버가 아직 처리하지 않은 입력(SavedMoves)을 다시 시뮬레이션한다.
+	// 4. 다른 클라이언트(Simulated Proxy)는 복제된 위치로 보간한다.
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+	virtual void PossessedBy(AController* NewController) override;
+
+protected:
+	UFUNCTION(Server, Unreliable)
+	void ServerMove(const FPracticeNetMove& Move, FVector_NetQuantize100 ClientLocation);
+
+	UFUNCTION(Client, Unreliable)
+	void ClientAckMove(uint32 TimeStamp);
+
+	UFUNCTION(Client, Unreliable)
+	void ClientAdjustPosition(const FPracticeNetCorrection& Correction);
+
+	UFUNCTION()
+	void OnRep_NetMovement();
+
+	UPROPERTY(ReplicatedUsing = OnRep_NetMovement)
+	FPracticeRepMovement NetMovement;
+
+	// Simulated Proxy의 위치 보간 속도
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|Network")
+	float SimulatedInterpSpeed = 15.0f;
+
+private:
+	void TickAutonomousProxy(float DeltaTime);
+	void TickSimulatedProxy(float DeltaTime);
+	// 이동 입력 하나를 적용하고 시뮬레이션한다. 서버 처리, 클라이언트 예측, 재시뮬레이션에서 같이 사용한다.
+	void SimulateNetMove(const FPracticeNetMove& Move);
+	void RemoveAckedMoves(uint32 TimeStamp);
+	// 서버 : 현재 상태로 클라이언트를 보정한다.
+	void SendNetCorrection(uint32 TimeStamp);
+	// 서버 : 마지막 갱신 이후 지난 서버 시간만큼 입력 시간 예산을 채운다.
+	void RefillMoveTimeBudget();
+	void ReportNetStats();
+
+	// 클라이언트 : 서버가 아직 확인하지 않은 입력
+	TArray<FPracticeNetMove> SavedMoves;
+	uint32 ClientTimeStamp = 0;
+	uint32 ClientAckedTimeStamp = 0;
+	// ms 단위로 보내고 남은 시간
+	float ClientTimeRemainder = 0.0f;
+
+	// 서버 : 마지막으로 처리한 입력, 순서가 바뀐 입력은 버린다.
+	uint32 ServerTimeStamp = 0;
+	// 서버 : 클라이언트 입력에 쓸 수 있는 남은 시간(초)과 마지막으로 채운 서버 시간, 음수이면 아직 입력을 받지 않았다.
+	float ServerMoveTimeBudget = 0.0f;
+	double ServerMoveBudgetTime = -1.0;
+
+	int32 NetMoveCount = 0;
+	int32 NetCorrectionCount = 0;
+	int32 NetRejectedMoveCount = 0;
+	double NetReportStartTime = 0.0;
+
 public:
 	// Move 아이디어
 	// 1. 이동 방향을 Input에서 지정, Tick에서 Input을 기록된 Input을 이용해서 이동 처리
@@ -83,6 +201,13 @@ public:
 	// 올라갈 수 있는 계단 높이
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Movement)
 	float StepHeight;
+
+	// 수평 이동에서 충돌면을 따라 다시 이동하는 최대 횟수
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Movement, meta = (ClampMin = "1"))
+	int32 MaxSlideIterations;
+
+	// 마지막 이동에서 사용한 Sweep 횟수
+	int32 GetLastMoveSweepCount() const { return LastMoveSweepCount; }
 	
 protected:
 	// 현재 속력
@@ -102,13 +227,61 @@ protected:
 	float CalculateVelocity(float CurrentVelocity, float TargetVelocity, float DeltaTime) const;
 	// Controller 기준으로 이동 방향을 월드 벡터로 반환한다. 월드 벡터는 정규화되어 있다.
 	FVector GetMoveDirectionFromController() const;
+	// Controller 회전이 바뀌면 호출해서 이동 방향 계산에 사용할 기준 벡터를 갱신한다.
+	void RefreshControlBasis();
+
+	// 이번 프레임 Controller Yaw 기준 벡터, UpdateControllerRotation 후에 한 번 계산한다.
+	FPracticeYawBasis ControlBasis;
 	
 	void FaceDirection(FVector NewDirection, float DeltaTime, float Damp);
 	// 즉시 해당 방향을 바라보게 한다.
 	void FaceDirection(FVector NewDirection);
 
 	// 현재 속도에 맞추어서 실질적인 이동
-	void Move(float DeltaTime);
+	// bAllowAsyncProbe : 지면 검사에 한 프레임 늦은 비동기 Probe 결과를 사용할 수 있다. 한 프레임에 여러 번 시뮬레이션하면 false로 호출한다.
+	void Move(float DeltaTime, bool bAllowAsyncProbe = true);
+	// 다른 Pawn과 겹친 만큼 밀려나는 수평 이동량, 밀려나는 Pawn끼리는 Sweep에서 충돌하지 않는다.
+	// 클라이언트가 예측할 수 없으므로 서버에서만 적용한다.
+	FVector GetSeparationDelta(float DeltaTime) const;
+	// 플레이어가 조종하는 Pawn(원격 플레이어, Listen Server 호스트)은 밀려나지 않고 Sweep으로 다른 Pawn에 막힌다.
+	// 서버와 클라이언트 모두 PlayerState로 판단하므로 예측 이동의 충돌이 서버와 같다.
+	bool CanBePushed() const { return !IsPlayerControlled(); }
+	// 수평 / 수직 이동을 Sweep으로 처리하고 지면 판정 결과를 반환한다.
+	EPracticeSweepResult SweepMove(const FVector& HorizontalDelta, const FVector& VerticalDelta, bool bAllowAsyncProbe = true);
+	// 충돌면을 따라 미끄러지는 수평 이동(Collide and Slide)
+	void SlideMove(const FVector& Delta, bool bCanStepUp, int32& NumSweeps);
+	bool StepUp(const FVector& Delta, const FHitResult& Hit, int32& NumSweeps);
+	// AllowedSlopeAngle 이하의 경사면인지 확인한다.
+	bool IsWalkable(const FVector& ImpactNormal) const;
+
+public:
+	// 움직이는 발판(Base)
+	// 수직 Sweep에서 밟은 Component가 움직일 수 있으면 Base로 기록하고, UPracticeMovementBaseSubsystem이 Base의 이동량을 먼저 적용한다.
+	// 공중, 드론 상태에서는 Base가 없다. 지상 이동은 Yaw만 사용하므로 Base의 Yaw 회전만 따른다.
+	USceneComponent* GetMovementBase() const;
+
+protected:
+	void SetMovementBase(UPrimitiveComponent* NewBase);
+	// 이전 / 현재 Base Transform으로 Pawn을 Base와 함께 옮긴다. Base는 무시하고 Sweep하며, 막히면 Sleep 중이어도 깨운다.
+	void ApplyBaseMovement(UPrimitiveComponent* Base, const FTransform& OldBaseTransform, const FTransform& NewBaseTransform, float DeltaYaw);
+
+private:
+	// UPracticeMovementBaseSubsystem의 Group Index, Base가 없으면 INDEX_NONE
+	int32 MovementBaseIndex = INDEX_NONE;
+
+protected:
+	int32 LastMoveSweepCount = 0;
+
+#if !UE_BUILD_SHIPPING
+	// 수평 이동 충돌 디버그 : 충돌마다 출력하지 않고 모아서 일정 간격으로 요약한다.
+	void RecordSlideHitDebug(const FHitResult& Hit);
+
+	int32 DebugSlideHitCount = 0;
+	float DebugSlopeAngleSum = 0.0f;
+	double DebugSummaryStartTime = 0.0;
+#endif
+
+	FPracticeMovementParams GetMovementParams() const;
 
 public:
 	// Jump 아이디어
@@ -127,8 +300,17 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|Jump")
 	float TerminalSpeed;
 
+	// 착지 후 점프할 수 없는 시간, 0이면 잠그지 않는다. 잠금 중에는 Jump Buffer가 줄어들지 않는다.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|Jump")
 	float LandingLockTime;
+
+	// 점프할 수 없는 상태(공중, 착지 잠금)에서 누른 점프를 보관하는 시간, 0(기본값)이면 보관하지 않는다.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|Jump", meta = (ClampMin = "0.0"))
+	float JumpBufferTime;
+
+	// 지면에서 떨어진 뒤에도 점프할 수 있는 시간, 0(기본값)이면 사용하지 않는다.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|Jump", meta = (ClampMin = "0.0"))
+	float CoyoteTime;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|Jump")
 	float Gravity;
@@ -149,7 +331,18 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category = "Movement|Jump")
 	float FallSpeed;
 
-	// 움직이고 나서 설정이 되기 때문에 이동 방향을 구하는 중이라면 이전 프레임에서의 Fall 상태이다.
+	// 현재 이동 상태
+	// 움직이고 나서 설정이 되기 때문에 이동 방향을 구하는 중이라면 이전 프레임에서의 상태이다.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category = "Movement")
+	EPracticeMovementMode MovementMode;
+
+	// 현재 상태의 남은 시간, 0 이하가 되면 Timeout 이벤트가 발생한다.
+	float StateTimeRemaining;
+
+	// 상태와 별개인 짧은 타이머(Jump Buffer, Coyote Time), TickMovementMode에서 줄인다.
+	FPracticeMovementTimers MovementTimers;
+
+	// 아래 값들은 MovementMode에서 결정되는 값으로 Animation Blueprint에서 읽기 위해서 유지한다.
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category ="Movement|Jump")
 	bool bIsFall;
 
@@ -163,21 +356,142 @@ protected:
 	bool bApplyGravity;
 	
 	void UpdateFallSpeed(float DeltaTime);
-	bool IsOnGround();
+	// bAllowAsync : 이전 프레임에 제출한 비동기 Probe 결과를 사용할 수 있다.
+	bool IsOnGround(bool bAllowAsync = true);
 	void AirPlaneMove(float DeltaTime);
-	void LandStart();
-	void LandEnd();
-	
+
+	// 이벤트를 전이 표에 따라 처리하고 상태가 바뀌면 Exit / Enter를 호출한다.
+	void HandleMovementEvent(EPracticeMovementEvent Event);
+	void SetMovementMode(EPracticeMovementMode NewMode);
+	void OnEnterMovementMode(EPracticeMovementMode PrevMode);
+	void OnExitMovementMode(EPracticeMovementMode NextMode);
+	// 상태의 남은 시간과 이동 타이머를 줄이고 상태 시간이 끝나면 Timeout 이벤트를 보낸다.
+	// 이동이 끝난 뒤에 호출한다.
+	void TickMovementMode(float DeltaTime);
+	void UpdateMovementModeFlags();
+
+public:
+	EPracticeMovementMode GetMovementMode() const { return MovementMode; }
+	bool IsMovingOnGround() const { return PracticeMovement::IsGroundMode(MovementMode); }
+
+public:
+	// 이동 갱신 단계(LOD)
+	// UPracticeSignificanceSubsystem이 로컬 플레이어 카메라와의 거리, 가시성으로 결정한다.
+	// Mid, Far는 TickInterval 간격으로 누적된 DeltaTime을 사용해서 갱신하고 Animation도 같은 간격으로 갱신한다.
+	// Far에서 지상 이동 중이면 Sweep, 지면 검사 없이 이동한다.
+	void SetSignificance(EPracticeSignificance NewSignificance, float TickInterval);
+	EPracticeSignificance GetSignificance() const { return Significance; }
+
+	class UCameraComponent* GetCameraComponent() const { return CameraComponent; }
+
+protected:
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category = "Movement|Significance")
+	EPracticeSignificance Significance = EPracticeSignificance::Near;
+
+	bool ShouldUseKinematicMove() const { return Significance == EPracticeSignificance::Far && IsMovingOnGround(); }
+	// 충돌 검사 없이 수평으로만 이동한다.
+	// 다른 Pawn의 밀어내기(SeparationDelta)는 군중에 밀려 벽을 뚫지 않도록 따로 Sweep한다.
+	// Base의 수평 범위를 벗어나면 Base에서 내린다.
+	void KinematicMove(const FVector& HorizontalDelta, const FVector& SeparationDelta);
+
+public:
+	// 정지 상태(Sleep)
+	// 지면에 서 있고 이동 / Look 입력과 속도가 없는 상태가 SleepDelay 동안 이어지면 Actor Tick을 끈다. 이동, Sweep, 지면 검사를 하지 않는다.
+	// 입력, 밀어내기, 발밑 Component의 이동과 제거, Hit / Overlap / Damage에서 깨어난다. 기록된 Base 위에서는 깨어나지 않고 Base와 함께 옮겨진다.
+	// 개별 Tick으로 움직이는 Pawn만 사용한다. 배치 이동, 외부 Stepping, 네트워크 Proxy는 Tick을 사용하지 않거나 따로 처리한다.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|Sleep")
+	bool bCanSleep;
+
+	// 정지 상태가 이어져야 하는 시간(초)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|Sleep", meta = (ClampMin = "0.0"))
+	float SleepDelay;
+
+	bool IsSleeping() const { return bIsSleeping; }
+	void WakeUp();
+
+	virtual void NotifyHit(class UPrimitiveComponent* MyComp, AActor* Other, class UPrimitiveComponent* OtherComp, bool bSelfMoved, FVector HitLocation, FVector HitNormal, FVector NormalImpulse, const FHitResult& Hit) override;
+	virtual void NotifyActorBeginOverlap(AActor* OtherActor) override;
+	virtual float TakeDamage(float DamageAmount, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser) override;
+
+protected:
+	bool CanSleep() const;
+	// 정지 상태가 SleepDelay 동안 이어지면 Sleep으로 들어간다. Tick의 마지막에 호출한다.
+	void UpdateSleep(float DeltaTime);
+	void Sleep();
+	void OnSleepBaseMoved(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+	UFUNCTION()
+	void OnSleepBasePhysicsStateChanged(UPrimitiveComponent* ChangedComponent, EComponentPhysicsStateChange StateChange);
+
 private:
-	FTimerHandle LandingLockTimerHandle;
+	bool bIsSleeping = false;
+	float IdleTime = 0.0f;
+	// Sleep 중에 움직이면 깨어나는 발밑 Component, 움직일 수 있는 Component일 때만 기록한다.
+	TWeakObjectPtr<USceneComponent> SleepBase;
+	FDelegateHandle SleepBaseMovedHandle;
 	
 public:
 	// 드론 모드
 	// 드론 모드에서는 6 자유도 이동을 하게 된다.
 	// 현재 이동에서는 캐릭터의 이동 방향으로 회전을 구현하게 했으나 드론 모드에서는 회전이 마우스로 조정이 된다.
+	// 구현
+	// 1. 이동 입력(X : 전후, Y : 좌우)과 상승 입력(Z)을 Actor 기준 방향의 추력으로 사용한다.
+	// 2. 속도는 추력과 공기 저항으로 계산한다. 중력과 지면 검사는 하지 않는다.
+	// 3. Actor의 회전은 Controller의 회전(Pitch, Yaw, Roll)을 그대로 따른다. Roll은 입력으로 AddControllerRotation에 더한다.
 	
+	// MovementMode에서 결정되는 값
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement|Drone")
 	bool IsDrone;
+
+	// 추력에 의한 가속도
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|Drone")
+	float DroneThrust;
+
+	// 공기 저항 계수, 클수록 빨리 멈춘다.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|Drone")
+	float DroneDrag;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|Drone")
+	float DroneMaxSpeed;
+
+	// 초당 Roll 회전 각도
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|Drone")
+	float DroneRollSpeed;
+
+protected:
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category = "Movement|Drone")
+	FVector DroneVelocity;
+
+	// 상승 / 하강 입력
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category = "Movement|Drone")
+	float DroneThrustInput;
+
+	UFUNCTION()
+	void DroneToggleInput(const FInputActionValue& Value);
+
+	UFUNCTION()
+	void DroneThrustInputChanged(const FInputActionValue& Value);
+
+	UFUNCTION()
+	void DroneRollInput(const FInputActionValue& Value);
+
+	void DroneMove(float DeltaTime);
+	void EnterDrone();
+	void ExitDrone();
+
+public:
+	// 배치 이동
+	// true일 경우 개별 Tick 대신 UPracticeMovementSubsystem에서 이동을 처리한다.
+	// 이동 상태는 Subsystem이 가지고 있고, Character의 값은 Animation 등에서 읽기 위한 복사본이다.
+	// 튜닝 값은 등록할 때 복사하고, 고정 시간 간격과 Sleep은 사용하지 않는다.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement|Batch")
+	bool bUseBatchedMovement;
+
+	bool IsBatchedMovement() const { return BatchedMovementIndex != INDEX_NONE; }
+
+private:
+	int32 BatchedMovementIndex = INDEX_NONE;
+
+	class UPracticeMovementSubsystem* GetBatchedMovementSubsystem() const;
 	
 public:
 	// Look : 3인칭 시점 구현 : Spring Arm이 Controller에 대응되게 회전, Camera 위치 고정
@@ -186,25 +500,113 @@ public:
 	// 1. Tick에서 Controller의 회전을 계산
 	// 2. Controller의 회전에 따라 Camera의 방향을 결정
 	
+	// 마우스 이동량 1당 회전 각도
+	// 마우스 입력은 프레임 사이의 이동량이므로 DeltaTime을 곱하지 않는다. 프레임 수와 관계없이 같은 이동량은 같은 각도가 된다.
+	// 이전에는 초당 각도(기본 180)였다. Blueprint에서 바꾼 값은 60 FPS 기준으로 60으로 나누어 옮긴다.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Camera)
 	float MouseXSensitive;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Camera)
 	float MouseYSensitive;
 
+	// 한 프레임에 적용할 수 있는 최대 회전 각도
+	// LookSmoothingTime을 사용하면 넘는 부분은 다음 프레임으로 넘기고, 사용하지 않으면 버린다.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Camera)
 	FRotator MaxControllerRotation;
 
+	// Controller Pitch 범위, 드론 상태에서는 제한하지 않는다.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Camera, meta = (ClampMin = "-89.0", ClampMax = "89.0"))
+	float MinViewPitch;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Camera, meta = (ClampMin = "-89.0", ClampMax = "89.0"))
+	float MaxViewPitch;
+
+	// 마우스 가속 : X는 초당 마우스 이동량, Y는 감도 배율. Key가 없으면 사용하지 않는다.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Camera)
+	FRuntimeFloatCurve LookAccelerationCurve;
+
+	// 회전을 부드럽게 적용하는 시간 상수(초), 0이면 바로 적용한다.
+	// 남은 회전을 나누어 적용하므로 전체 회전 각도는 입력과 같다.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Camera, meta = (ClampMin = "0.0"))
+	float LookSmoothingTime;
+
+	// 다음 UpdateControllerRotation까지 모은 입력
+	// Pitch, Yaw : 마우스 이동량, Roll : 초당 각도
 	FRotator DeltaCameraRotator;
 
 	UFUNCTION(BlueprintCallable, Category="Input")
 	void AddControllerRotation(float Pitch, float Yaw, float Roll);
 
+	// Camera Rig(Spring Arm, Camera)는 이 클라이언트에서 플레이어가 조종하는 Pawn만 사용한다.
+	// 다른 Pawn은 Spring Arm을 Capsule에서 떼어 놓고 Tick을 꺼서 Transform 전파와 충돌 검사를 하지 않는다.
+	virtual void NotifyControllerChanged() override;
+	bool IsCameraRigActive() const { return bCameraRigActive; }
+
+protected:
+	// 플레이어 조종 여부가 바뀌면 밀어내기 충돌 설정을 다시 정한다.
+	virtual void OnPlayerStateChanged(APlayerState* NewPlayerState, APlayerState* OldPlayerState) override;
+
+public:
+
+	// 보는 사람이 없어도 Camera Rig를 유지한다. 벤치마크에서 비용을 비교할 때 사용한다.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera)
+	bool bAlwaysUseCameraRig;
+
+	// 늦은 Camera 갱신 : 켜면 Tick의 UpdateCamera는 아무것도 하지 않고 UpdateCameraLate에서 회전과 Spring Arm을 갱신한다.
+	// APracticeCameraManager가 View Target에 대해 켜고 매 프레임 UpdateCameraLate를 호출한다.
+	void SetLateCameraUpdate(bool bEnable);
+	bool IsLateCameraUpdate() const { return bLateCameraUpdate; }
+	void UpdateCameraLate(float DeltaTime);
+
 protected:
 	
 	// Controller의 방향에 따라 Camera의 회전을 결정
 	void UpdateControllerRotation(float DeltaTime);
 	void UpdateCamera();
+	void ApplyCameraRotation();
+
+	// 현재 Controller에 맞추어 Camera Rig를 켜거나 끈다. BeginPlay 전에는 처리하지 않는다.
+	void UpdateCameraRig();
+	void SetCameraRigActive(bool bActive);
+
+private:
+	// Constructor에서 Capsule에 붙어 있는 상태로 시작한다.
+	bool bCameraRigActive = true;
+	bool bLateCameraUpdate = false;
+
+	// LookSmoothingTime 동안 나누어 적용할 남은 회전
+	FRotator LookSmoothingRemainder = FRotator::ZeroRotator;
+	// 아직 Camera에 반영하지 않은 첫 Look 입력의 시간(Cycles64), 입력부터 Camera까지의 지연 측정에 사용한다.
+	uint64 LookInputCycles = 0;
+
+public:
+	// 고정 시간 간격 시뮬레이션
+	// DeltaTime이 커지면 얇은 벽을 통과하거나 점프 높이가 프레임에 따라 달라지는 문제가 있다.
+	// 이동을 FixedStepRate 간격으로 나누어서 처리하고, Mesh와 Camera는 마지막 두 상태 사이를 보간해서 보여준다.
+	// 배치 이동(bUseBatchedMovement)에서는 사용하지 않는다.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement|Simulation")
+	bool bUseFixedTimestep;
+
+	// 초당 시뮬레이션 횟수
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement|Simulation", meta = (EditCondition = "bUseFixedTimestep", ClampMin = "1.0"))
+	float FixedStepRate;
+
+	// 한 프레임에 처리할 수 있는 최대 시뮬레이션 횟수, 넘는 시간은 버린다.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement|Simulation", meta = (EditCondition = "bUseFixedTimestep", ClampMin = "1"))
+	int32 MaxSubSteps;
+
+protected:
+	// 지상 / 공중 이동 계산 후 실제 이동까지 한 번의 시뮬레이션
+	// bAllowAsyncProbe는 Move와 같다.
+	void SimulateMovement(float DeltaTime, bool bAllowAsyncProbe = true);
+	void TickFixedStep(float DeltaTime);
+	void ApplyRenderInterpolation(float Alpha);
+
+private:
+	float SimulationAccumulator = 0.0f;
+	FTransform PrevSimulationTransform;
+	FTransform MeshRelativeTransform;
+	FVector SpringArmRelativeLocation;
 	
 public:	
 	// Called every frame
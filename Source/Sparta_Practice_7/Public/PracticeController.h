@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerController.h"
+#include "PracticeInputRecording.h"
 #include "PracticeController.generated.h"
 
 /**
@@ -27,6 +28,59 @@ public:
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = Input)
 	TObjectPtr<class UInputAction> JumpAction;
+
+	// 드론 모드 전환
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = Input)
+	TObjectPtr<class UInputAction> DroneToggleAction;
+
+	// 드론 상승 / 하강 (1D Axis)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = Input)
+	TObjectPtr<class UInputAction> DroneThrustAction;
+
+	// 드론 Roll (1D Axis)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = Input)
+	TObjectPtr<class UInputAction> DroneRollAction;
 	
 	virtual void BeginPlay() override;
+	virtual void PlayerTick(float DeltaTime) override;
+
+public:
+	// 입력 기록 / 재생
+	// 기록 : 매 프레임 Pawn에 들어온 입력과 DeltaTime을 저장한다. (PracticeRecordStart / PracticeRecordStop)
+	// 재생 : 입력을 끄고 기록된 입력을 프레임마다 하나씩 Pawn에 넣고, Pawn의 이동을 직접 진행한다.
+	//		  DeltaTime은 실제 프레임 시간과 상관없이 기록된 값(혹은 고정 값)을 사용하므로 같은 파일은 항상 같은 결과가 나온다.
+	// 실행 인자
+	// -PracticeReplay=<파일>			시작하면 재생
+	// -PracticeReplayFixedStep=<Hz>	기록된 DeltaTime 대신 고정 시간 간격 사용
+	// -PracticeReplayGolden=<파일>		재생이 끝나면 마지막 상태를 비교하고 종료 코드로 결과를 반환한다. (0 : 같음, 1 : 다름)
+	// -PracticeReplayUpdateGolden		비교하지 않고 마지막 상태를 Golden 파일로 저장
+	UFUNCTION(Exec)
+	void PracticeRecordStart(const FString& FileName);
+
+	UFUNCTION(Exec)
+	void PracticeRecordStop();
+
+	UFUNCTION(Exec)
+	void PracticeReplay(const FString& FileName);
+
+	bool IsRecording() const { return bIsRecording; }
+	bool IsReplaying() const { return bIsReplaying; }
+
+private:
+	void RecordFrame(float DeltaTime);
+	void StartReplay();
+	void ReplayFrame();
+	void FinishReplay();
+
+	FPracticeInputRecording Recording;
+	FString RecordingFileName;
+	bool bIsRecording = false;
+
+	// 재생할 파일을 읽었지만 Pawn이 아직 없는 경우
+	bool bReplayPending = false;
+	bool bIsReplaying = false;
+	int32 ReplayFrameIndex = 0;
+	float ReplayFixedStep = 0.0f;
+	FString GoldenFileName;
+	bool bUpdateGolden = false;
 };
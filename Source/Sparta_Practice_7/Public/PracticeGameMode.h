@@ -6,6 +6,8 @@
 #include "GameFramework/GameModeBase.h"
 #include "PracticeGameMode.generated.h"
 
+class APracticeCharacter;
+
 /**
  * 
  */
@@ -16,4 +18,40 @@ class SPARTA_PRACTICE_7_API APracticeGameMode : public AGameModeBase
 
 public:
 	APracticeGameMode();	
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Pawn Pool
+	// APracticeCharacter는 Spawn할 때마다 Capsule, Mesh, Spring Arm, Camera를 만들기 때문에 한 번에 많이 Spawn하면 프레임이 끊긴다.
+	// 시작할 때 PawnPoolSize만큼 미리 만들어 두고, 반환된 Pawn은 Component를 유지한 채로 숨겨 두었다가 다시 사용한다.
+	// 풀이 비어 있으면 새로 Spawn한다.
+	APracticeCharacter* AcquirePawn(const FTransform& SpawnTransform);
+	void ReleasePawn(APracticeCharacter* Pawn);
+
+	int32 GetNumPooledPawns() const { return PawnPool.Num(); }
+
+protected:
+	// 시작할 때 미리 만들어 둘 Pawn 수, 명령줄 -PracticePawnPool=N 으로 바꿀 수 있다.
+	UPROPERTY(EditDefaultsOnly, Category = "Pool", meta = (ClampMin = "0"))
+	int32 PawnPoolSize;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Pool")
+	TSubclassOf<APracticeCharacter> PooledPawnClass;
+
+	// 반환된 Pawn을 놓아두는 위치
+	UPROPERTY(EditDefaultsOnly, Category = "Pool")
+	FVector PoolParkingLocation;
+
+private:
+	APracticeCharacter* SpawnPooledPawn(const FTransform& SpawnTransform);
+	void ReportPoolStats() const;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<APracticeCharacter>> PawnPool;
+
+	int32 PoolHitCount = 0;
+	int32 PoolMissCount = 0;
+	double PoolHitSeconds = 0.0;
+	double PoolMissSeconds = 0.0;
 };
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PracticeGroundCacheSubsystem.generated.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * 정적인 Level의 지면 높이 캐시(2.5D Heightfield)
+ * Level의 Static Collision을 격자 꼭짓점마다 위에서 아래로 Trace해서 높이를 구하고, 셀마다 경사(Normal Z)를 저장한다.
+ * 결과는 Saved/GroundCache/<Map>.pgc 파일로 저장하고 Memory Mapping으로 읽는다. 정적 Collision이 바뀌면 다시 만든다.
+ *
+ * 캐시로 답할 수 없는 셀은 물리 Trace를 사용한다.
+ * - 가장 위의 지면만 저장하므로 그보다 아래에 있는 경우(다리 밑, 1층)
+ * - 평면이 아닌 셀(계단 모서리), Trace가 없는 셀
+ * - 시작할 때 움직이는 Primitive가 있던 셀, MarkDynamic으로 지정한 셀
+ * - Pawn의 AllowedSlopeAngle보다 가파른 셀, 지면과의 거리가 판정 경계에 가까운 경우
+ * - 지면보다 떠 있는 경우, 나중에 생기거나 움직인 물체가 발밑에 있을 수 있으므로 캐시는 지면 위에 있다는 답만 한다.
+ *
+ * practice.GroundCache.Enable 1로 켜고, 시작할 때 만들거나 읽는다. practice.GroundCache.Rebuild로 다시 만든다.
+ */
+UCLASS()
+class SPARTA_PRACTICE_7_API UPracticeGroundCacheSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	bool IsReady() const { return Heights != nullptr; }
+
+	// FootLocation에서 CheckDistance 아래까지 지면이 있는지 확인한다. (IsOnGround의 Line Trace와 같은 판정)
+	// 캐시로 답할 수 있으면 true를 반환하고 결과를 bOutOnGround에 넣는다. false면 물리 Trace를 사용한다.
+	// 캐시로 답하는 경우는 지면 위에 있는 경우뿐이다.
+	bool QueryGround(const FVector& FootLocation, float CheckDistance, float WalkableNormalZ, bool& bOutOnGround) const;
+
+	// Bounds와 겹치는 셀은 물리 Trace를 사용한다. 움직이는 발판 등 Level에 나중에 추가된 물체에서 호출한다.
+	void MarkDynamic(const FBox& Bounds);
+
+	// 캐시 파일을 다시 만든다.
+	void Rebuild();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// 파일 헤더, 뒤에 꼭짓점 높이(float, (NumX + 1) * (NumY + 1)), 셀 경사(uint8, NumX * NumY)가 이어진다.
+	struct FHeader
+	{
+		uint32 Magic = 0;
+		uint32 Version = 0;
+		uint32 GeometryHash = 0;
+		int32 NumX = 0;
+		int32 NumY = 0;
+		float CellSize = 0.0f;
+		float OriginX = 0.0f;
+		float OriginY = 0.0f;
+		// 만들 때 허용한 높이 오차, 조회에서 판정 경계의 여유로 사용한다.
+		float Tolerance = 0.0f;
+		uint32 Padding = 0;
+	};
+
+	static constexpr uint32 Magic = 0x43475250; // 'PRGC'
+	static constexpr uint32 Version = 1;
+
+	// 경사 값 0 : 캐시를 사용하지 않는 셀, 1 ~ 255 : Normal Z를 0 ~ 1로 양자화한 값
+	static constexpr uint8 UnusableCell = 0;
+
+	FString GetCachePath() const;
+	// 정적 Collision의 Bounds, Transform, Mesh Asset으로 만든 Hash와 전체 Bounds
+	uint32 ComputeGeometryHash(FBox& OutBounds) const;
+	bool Load(const FString& Path, uint32 GeometryHash);
+	bool Build(const FString& Path, const FBox& Bounds, uint32 GeometryHash);
+	void Unload();
+	// 움직이는 Primitive가 있는 셀과 MarkDynamic으로 지정한 셀을 표시한다.
+	void MarkDynamicPrimitives();
+	void MarkDynamicCells(const FBox& Bounds);
+	// 같은 조건의 물리 Trace와 비교해서 속도 차이를 기록한다.
+	void ReportQuerySpeed() const;
+
+	// Memory Mapping을 지원하지 않는 환경에서는 파일을 읽어서 사용한다.
+	TUniquePtr<IMappedFileHandle> MappedHandle;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TArray64<uint8> LoadedData;
+
+	FHeader Header;
+	const float* Heights = nullptr;
+	const uint8* CellNormals = nullptr;
+	// 실행 중에만 사용하는 셀 표시, 파일에는 저장하지 않는다.
+	TBitArray<> DynamicCells;
+	// MarkDynamic으로 지정한 영역, Rebuild 후에 다시 표시한다.
+	TArray<FBox> MarkedBounds;
+};
@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "WorldCollision.h"
+#include "PracticeGroundProbeSubsystem.generated.h"
+
+/**
+ * APracticeCharacter의 지면 검사(IsOnGround)를 비동기 Line Trace로 처리하는 Subsystem
+ * 한 프레임 동안 요청된 Probe는 World의 Async Trace로 모아서 프레임 끝에 한 번에 처리되고, 결과는 다음 프레임에 사용한다.
+ * 결과가 아직 없으면 설정에 따라 동기 Trace를 하거나 마지막 결과를 사용한다.
+ */
+UCLASS()
+class SPARTA_PRACTICE_7_API UPracticeGroundProbeSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Start에서 End까지 지면이 있는지 확인한다.
+	// 비동기 모드에서는 이전 프레임에 제출한 Probe의 결과를 반환하고 이번 프레임의 Probe를 제출한다.
+	bool Probe(const AActor* Pawn, const FVector& Start, const FVector& End);
+
+	void Forget(const AActor* Pawn);
+
+	// 동기 Trace
+	static bool TraceSync(const UWorld* World, const AActor* Pawn, const FVector& Start, const FVector& End);
+	static bool TraceSync(const UWorld* World, const AActor* Pawn, const FVector& Start, const FVector& End, FHitResult& OutHit);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FGroundProbe
+	{
+		FTraceHandle Handle;
+		uint64 SubmitFrame = 0;
+		bool bHasLastResult = false;
+		bool bLastResult = false;
+	};
+
+	TMap<FObjectKey, FGroundProbe> Probes;
+};
@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PracticeMovementTypes.h"
+
+// 한 프레임 동안의 입력 버튼
+namespace EPracticeInputButtons
+{
+	enum Type : uint8
+	{
+		None		= 0,
+		Jump		= 1 << 0,
+		DroneToggle	= 1 << 1,
+	};
+}
+
+// 한 프레임의 입력, 재생하면 같은 순서로 Pawn에 전달한다.
+// 파일 크기를 줄이기 위해 float로 저장한다. 재생끼리는 같은 값을 사용하므로 결과가 같다.
+struct FPracticeInputFrame
+{
+	float DeltaTime = 0.0f;
+	FVector2f MoveInput = FVector2f::ZeroVector;
+	// UpdateControllerRotation 전에 누적된 회전 입력(DeltaCameraRotator)
+	FRotator3f LookInput = FRotator3f::ZeroRotator;
+	float DroneThrustInput = 0.0f;
+	uint8 Buttons = EPracticeInputButtons::None;
+
+	friend FArchive& operator<<(FArchive& Ar, FPracticeInputFrame& Frame)
+	{
+		Ar << Frame.DeltaTime << Frame.MoveInput << Frame.LookInput << Frame.DroneThrustInput << Frame.Buttons;
+		return Ar;
+	}
+};
+
+/**
+ * 입력 기록 파일
+ * [Magic][Version][시작 상태][프레임 수][프레임...] 순서의 Binary 파일이다.
+ * 상대 경로는 Saved/InputRecordings 기준이다.
+ */
+struct SPARTA_PRACTICE_7_API FPracticeInputRecording
+{
+	static constexpr uint32 Magic = 0x4E495250; // 'PRIN'
+	// 2 : 시작 상태에 이동 타이머 추가
+	// 3 : LookInput이 마우스 이동량 그대로(DeltaTime, 초당 감도 없음)로 바뀌어서 이전 기록은 다른 회전으로 재생된다.
+	static constexpr uint32 Version = 3;
+
+	FPracticeMovementSnapshot StartState;
+	TArray<FPracticeInputFrame> Frames;
+
+	bool Save(const FString& FileName) const;
+	bool Load(const FString& FileName);
+
+	static FString ResolvePath(const FString& FileName);
+
+	// 재생 결과(마지막 상태)를 저장 / 읽기
+	static bool SaveSnapshot(const FString& FileName, const FPracticeMovementSnapshot& Snapshot);
+	static bool LoadSnapshot(const FString& FileName, FPracticeMovementSnapshot& OutSnapshot);
+};
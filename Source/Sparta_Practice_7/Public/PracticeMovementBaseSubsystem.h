@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/PrimitiveComponent.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PracticeMovementBaseSubsystem.generated.h"
+
+class APracticeCharacter;
+
+/**
+ * 움직이는 발판(Base) 위의 APracticeCharacter를 함께 옮기는 Subsystem
+ * Pawn은 Sweep 이동의 수직 충돌에서 발밑 Component를 기록하고, 움직일 수 있는(Movable) Component면 여기에 등록한다.
+ * Base마다 마지막 Transform을 가지고 있다가 Base가 움직이면(TransformUpdated) 이동량을 한 번 계산해서 같은 Base의 모든 Pawn에 적용한다.
+ * Base가 움직인 직후에 적용되므로 Pawn의 Tick 순서와 관계없이 Pawn의 이동보다 먼저 처리된다. Sleep 중인 Pawn도 깨우지 않고 옮긴다.
+ * 옮기는 Sweep이 막히거나 Base의 물리 상태가 없어지면(Destroy, 충돌 끔) Pawn을 깨운다.
+ */
+UCLASS()
+class SPARTA_PRACTICE_7_API UPracticeMovementBaseSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Pawn의 Base를 바꾼다. nullptr이면 등록을 해제한다.
+	void SetBase(APracticeCharacter* Pawn, USceneComponent* NewBase);
+	USceneComponent* GetBase(int32 Index) const { return Groups.IsValidIndex(Index) ? Groups[Index].Base.Get() : nullptr; }
+
+	int32 GetNumBases() const { return Groups.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// 같은 Base 위의 Pawn
+	struct FBaseGroup
+	{
+		TWeakObjectPtr<USceneComponent> Base;
+		FObjectKey BaseKey;
+		FTransform LastTransform;
+		FDelegateHandle MovedHandle;
+		TArray<TWeakObjectPtr<APracticeCharacter>> Riders;
+	};
+
+	void RemoveRider(int32 GroupIndex, APracticeCharacter* Pawn);
+	void RemoveGroup(int32 GroupIndex);
+	void OnBaseMoved(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+	UFUNCTION()
+	void OnBasePhysicsStateChanged(UPrimitiveComponent* ChangedComponent, EComponentPhysicsStateChange StateChange);
+
+	// Pawn은 자신의 Group Index(MovementBaseIndex)를 가지고 있다.
+	TArray<FBaseGroup> Groups;
+	TMap<FObjectKey, int32> GroupIndices;
+};
@@ -0,0 +1,127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PracticeMovementProfiler.h"
+#include "PracticeMovementBenchmark.generated.h"
+
+class APracticeCharacter;
+class APracticeMovingPlatform;
+
+/**
+ * APracticeCharacter 이동 벤치마크
+ * -PracticeBench 인자로 실행하면 Pawn을 N개 생성해서 스크립트 입력으로 일정 프레임 동안 움직이고,
+ * 구간별 프레임 시간(mean / p50 / p99)과 물리 쿼리 수를 CSV, JSON으로 저장한 뒤 종료한다.
+ *
+ * 예) UnrealEditor-Cmd Sparta_Practice_7.uproject /Game/Maps/TestMap -game -nullrhi -unattended -nosound
+ *     -PracticeBench -PracticeBenchCounts=1,100,1000,10000 -PracticeBenchFrames=600
+ *
+ * 인자
+ * -PracticeBenchCounts=	생성할 Pawn 수 목록 (기본값 1,100,1000,10000)
+ * -PracticeBenchFrames=	측정 프레임 수 (기본값 600)
+ * -PracticeBenchWarmup=	측정 전에 버리는 프레임 수 (기본값 60)
+ * -PracticeBenchOut=		결과 파일 경로(확장자 제외), 기본값은 Saved/Profiling/PracticeBench/<시간>
+ * -PracticeBenchBatched	배치 이동(UPracticeMovementSubsystem) 사용
+ * -PracticeBenchCameraRigs	모든 Pawn의 Camera Rig 사용, Look 입력 지연(LookLatencyMs)은 Camera Rig가 있는 Pawn만 측정한다.
+ * -PracticeBenchLateCamera	Camera Rig를 Pawn Tick 대신 모든 이동이 끝난 뒤에 갱신 (APracticeCameraManager와 같은 시점)
+ * -PracticeBenchIdle=		입력 없이 서 있는 Pawn의 비율(%), 기본값 0. 정지 상태(Sleep)의 비용을 측정한다.
+ * -PracticeBenchPlatforms=	Pawn 아래에 만들 움직이는 발판 수, 기본값 0. Pawn은 발판 위에서 시작한다.
+ * -PracticeBenchNoExit		끝나도 종료하지 않음
+ */
+UCLASS()
+class SPARTA_PRACTICE_7_API UPracticeMovementBenchmark : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	enum class EPhase : uint8
+	{
+		Idle,
+		Warmup,
+		Measure,
+		Done,
+	};
+
+	// 측정 항목 : 구간별 시간(ms), 프레임 시간(ms), Sweep 수, Trace 수, Look 입력부터 Camera까지의 지연(ms), Sleep 중인 Pawn 수, 발판 위의 Pawn 수
+	static constexpr int32 NumSections = static_cast<int32>(EPracticeMovementSection::MAX);
+	static constexpr int32 FrameMetric = NumSections;
+	static constexpr int32 SweepMetric = NumSections + 1;
+	static constexpr int32 TraceMetric = NumSections + 2;
+	static constexpr int32 LookLatencyMetric = NumSections + 3;
+	static constexpr int32 SleepingMetric = NumSections + 4;
+	static constexpr int32 BasedMetric = NumSections + 5;
+	static constexpr int32 NumMetrics = NumSections + 6;
+
+	// Pawn 격자 간격, 발판을 사용할 때 Pawn을 띄우는 높이(cm)
+	static constexpr float PawnSpacing = 150.0f;
+	static constexpr float PlatformLift = 300.0f;
+
+	static FString GetMetricName(int32 Metric);
+
+	struct FResult
+	{
+		int32 NumPawns = 0;
+		double Mean[NumMetrics] = {};
+		double P50[NumMetrics] = {};
+		double P99[NumMetrics] = {};
+	};
+
+	void StartRun(int32 RunIndex);
+	void EndRun();
+	void SpawnPawns(int32 Count);
+	void DestroyPawns();
+	// Pawn 격자를 NumPlatforms개의 발판으로 나누어 Pawn 아래에 만든다.
+	void SpawnPlatforms();
+	void DestroyPlatforms();
+	void DriveInput();
+	bool IsIdlePawn(int32 Index) const { return Index % 100 < IdlePercent; }
+	void UpdateLateCameras(float DeltaTime);
+	void RecordFrame(float DeltaTime);
+	void WriteResults() const;
+	void Finish();
+
+	EPhase Phase = EPhase::Idle;
+	TArray<int32> PawnCounts;
+	int32 CurrentRun = INDEX_NONE;
+	int32 NumMeasureFrames = 600;
+	int32 NumWarmupFrames = 60;
+	int32 FrameInPhase = 0;
+	bool bUseBatchedMovement = false;
+	// 모든 Pawn의 Camera Rig를 켜서 Camera Rig를 끈 경우와 비교한다.
+	bool bUseCameraRigs = false;
+	// Camera Manager 대신 벤치마크 Tick에서 Camera를 늦게 갱신한다.
+	bool bUseLateCamera = false;
+	// 입력을 넣지 않는 Pawn의 비율(%)
+	int32 IdlePercent = 0;
+	int32 NumPlatforms = 0;
+	bool bExitWhenDone = true;
+	FString OutputPath;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<APracticeCharacter>> Pawns;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<APracticeMovingPlatform>> Platforms;
+
+	// Pawn 격자의 중심과 간격, 발판 배치에 사용한다.
+	FVector PawnGridOrigin = FVector::ZeroVector;
+	int32 PawnGridSize = 0;
+
+	// 항목별 프레임 측정값
+	TArray<double> Samples[NumMetrics];
+	double LastFrameTime = 0.0;
+	TArray<FResult> Results;
+};
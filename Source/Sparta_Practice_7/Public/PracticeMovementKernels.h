@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PracticeMovementTypes.h"
+
+// 배치 계산에서 사용하는 Pawn별 튜닝 값
+// FPracticeMovementParams 중 SIMD 계산에 필요한 값만 SoA로 가지고 있다.
+struct SPARTA_PRACTICE_7_API FPracticeMovementParamLanes
+{
+	TArray<float> MoveSpeed;
+	TArray<float> AccelDamp;
+	TArray<float> Gravity;
+	TArray<float> FallMultiplier;
+	TArray<float> TerminalSpeed;
+
+	void Add(const FPracticeMovementParams& Params);
+	void RemoveAtSwap(int32 Index);
+	void Reset();
+};
+
+/**
+ * 배치 이동 계산 함수
+ * PracticeMovement의 Scalar 함수를 VectorRegister로 4 Lane씩 처리하고 남은 Lane은 Scalar 함수로 처리한다.
+ * Lane 배열의 값이 0보다 큰 Lane만 갱신하고 나머지 Lane은 분기 없이 원래 값을 유지한다.
+ * float로 계산하므로 Scalar 함수와 완전히 같지 않고 허용 오차 안에서 같다.
+ * 자동화 테스트 Practice.Movement.Kernels로 확인하고, 실행 중에는 practice.Movement.ValidateKernels로 확인한다.
+ */
+namespace PracticeMovementKernels
+{
+	inline constexpr int32 LaneWidth = 4;
+
+	// 지상 Lane : Velocity = PracticeMovement::CalculateVelocity(Velocity, TargetVelocity, AccelDamp, DeltaTime)
+	SPARTA_PRACTICE_7_API void CalculateVelocity(float* RESTRICT Velocity, const float* RESTRICT TargetVelocity, const float* RESTRICT AccelDamp,
+		const float* RESTRICT DeltaTime, const float* RESTRICT GroundLane, int32 Num);
+
+	// 지상, 공중 Lane : FallSpeed = PracticeMovement::UpdateFallSpeed(FallSpeed, ...)
+	// 지상 Lane은 낙하 속도 0에서 시작한다.
+	SPARTA_PRACTICE_7_API void UpdateFallSpeed(float* RESTRICT FallSpeed, const float* RESTRICT Gravity, const float* RESTRICT FallMultiplier,
+		const float* RESTRICT TerminalSpeed, const float* RESTRICT DeltaTime, const float* RESTRICT GroundLane, const float* RESTRICT AirLane, int32 Num);
+
+	// 공중 Lane : PracticeMovement::ClampAirSpeed(Speed, MaxSpeed, Velocity, Direction)
+	// Speed 배열은 입력으로 최대 속도 제한 전 속도를 받고 결과로 이동 방향을 돌려준다.
+	SPARTA_PRACTICE_7_API void ClampAirSpeed(float* RESTRICT Velocity, float* RESTRICT SpeedX, float* RESTRICT SpeedY, float* RESTRICT SpeedZ,
+		const float* RESTRICT MaxSpeed, const float* RESTRICT AirLane, int32 Num);
+}
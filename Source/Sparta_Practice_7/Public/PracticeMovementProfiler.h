@@ -0,0 +1,122 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// 벤치마크에서 구간별 시간을 측정하기 위한 구간
+enum class EPracticeMovementSection : uint8
+{
+	Tick,
+	PlaneMove,
+	AirPlaneMove,
+	Move,
+	IsOnGround,
+	UpdateCamera,
+	BatchedPass,
+	MAX
+};
+
+#define PRACTICE_MOVEMENT_PROFILER !UE_BUILD_SHIPPING
+
+#if PRACTICE_MOVEMENT_PROFILER
+
+/**
+ * 이동 코드의 구간별 시간과 물리 쿼리 수를 프레임 단위로 모은다.
+ * 벤치마크가 실행 중일 때만 기록하며 Game Thread에서만 사용한다.
+ */
+struct SPARTA_PRACTICE_7_API FPracticeMovementProfiler
+{
+	struct FFrame
+	{
+		uint64 Cycles[static_cast<int32>(EPracticeMovementSection::MAX)] = {};
+		uint32 Sweeps = 0;
+		uint32 Traces = 0;
+		// Look 입력부터 Camera 회전 적용까지의 가장 긴 시간, LookSamples가 0이면 측정하지 않은 프레임이다.
+		uint64 LookLatencyCycles = 0;
+		uint32 LookSamples = 0;
+	};
+
+	static bool IsEnabled() { return bEnabled; }
+	static void SetEnabled(bool bInEnabled) { bEnabled = bInEnabled; }
+
+	static void AddCycles(EPracticeMovementSection Section, uint64 Cycles)
+	{
+		CurrentFrame.Cycles[static_cast<int32>(Section)] += Cycles;
+	}
+
+	static void CountSweeps(int32 Count)
+	{
+		if (bEnabled)
+		{
+			CurrentFrame.Sweeps += Count;
+		}
+	}
+
+	static void CountTraces(int32 Count)
+	{
+		if (bEnabled)
+		{
+			CurrentFrame.Traces += Count;
+		}
+	}
+
+	static void RecordLookLatency(uint64 Cycles)
+	{
+		if (bEnabled)
+		{
+			CurrentFrame.LookLatencyCycles = FMath::Max(CurrentFrame.LookLatencyCycles, Cycles);
+			++CurrentFrame.LookSamples;
+		}
+	}
+
+	// 현재 프레임 기록을 반환하고 초기화한다.
+	static FFrame ConsumeFrame()
+	{
+		const FFrame Frame = CurrentFrame;
+		CurrentFrame = FFrame();
+		return Frame;
+	}
+
+	static const TCHAR* GetSectionName(EPracticeMovementSection Section);
+
+private:
+	static bool bEnabled;
+	static FFrame CurrentFrame;
+};
+
+// 함수 단위 시간 측정
+struct FPracticeMovementScope
+{
+	explicit FPracticeMovementScope(EPracticeMovementSection InSection)
+		: Section(InSection)
+		, StartCycles(FPracticeMovementProfiler::IsEnabled() ? FPlatformTime::Cycles64() : 0)
+	{
+	}
+
+	~FPracticeMovementScope()
+	{
+		if (StartCycles != 0)
+		{
+			FPracticeMovementProfiler::AddCycles(Section, FPlatformTime::Cycles64() - StartCycles);
+		}
+	}
+
+private:
+	EPracticeMovementSection Section;
+	uint64 StartCycles;
+};
+
+#define PRACTICE_MOVEMENT_SCOPE(Section) FPracticeMovementScope PREPROCESSOR_JOIN(PracticeMovementScope_, __LINE__)(EPracticeMovementSection::Section)
+#define PRACTICE_MOVEMENT_COUNT_SWEEPS(Count) FPracticeMovementProfiler::CountSweeps(Count)
+#define PRACTICE_MOVEMENT_COUNT_TRACES(Count) FPracticeMovementProfiler::CountTraces(Count)
+#define PRACTICE_MOVEMENT_RECORD_LOOK_LATENCY(Cycles) FPracticeMovementProfiler::RecordLookLatency(Cycles)
+
+#else
+
+#define PRACTICE_MOVEMENT_SCOPE(Section)
+#define PRACTICE_MOVEMENT_COUNT_SWEEPS(Count)
+#define PRACTICE_MOVEMENT_COUNT_TRACES(Count)
+#define PRACTICE_MOVEMENT_RECORD_LOOK_LATENCY(Cycles)
+
+#endif
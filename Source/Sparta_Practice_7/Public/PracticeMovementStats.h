@@ -0,0 +1,107 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+// stat PracticeMovement 로 확인한다.
+DECLARE_STATS_GROUP(TEXT("PracticeMovement"), STATGROUP_PracticeMovement, STATCAT_Advanced);
+
+// 배치 처리
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Batched Movement"), STAT_PracticeBatchedMovement, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Batched Gather"), STAT_PracticeBatchedGather, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Batched Integrate"), STAT_PracticeBatchedIntegrate, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Batched Commit"), STAT_PracticeBatchedCommit, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Batched Pawns"), STAT_PracticeBatchedPawns, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Batched ms / 1000 Pawns"), STAT_PracticeBatchedMsPer1000, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+
+// 개별 Actor Tick
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Actor Tick Pawns"), STAT_PracticeActorTickPawns, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Actor Tick ms / 1000 Pawns"), STAT_PracticeActorTickMsPer1000, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+
+// 지면 검사
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Ground Probes Issued"), STAT_PracticeGroundProbeIssued, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Ground Probes Batched"), STAT_PracticeGroundProbeBatched, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Ground Probes Late"), STAT_PracticeGroundProbeLate, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+
+// 고정 시간 간격 시뮬레이션
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Fixed Sub-steps"), STAT_PracticeFixedSubSteps, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+
+// 이동 Sweep
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Move Sweeps"), STAT_PracticeMoveSweeps, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+
+// 개별 이동 단계
+DECLARE_CYCLE_STAT_EXTERN(TEXT("UpdateControllerRotation"), STAT_PracticeUpdateControllerRotation, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("PlaneMove"), STAT_PracticePlaneMove, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AirPlaneMove"), STAT_PracticeAirPlaneMove, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Move Horizontal Sweep"), STAT_PracticeHorizontalSweep, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Move Vertical Sweep"), STAT_PracticeVerticalSweep, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("IsOnGround"), STAT_PracticeIsOnGround, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("UpdateCamera"), STAT_PracticeUpdateCamera, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Active Camera Rigs"), STAT_PracticeActiveCameraRigs, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Spring Arm Probes"), STAT_PracticeSpringArmProbes, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Spring Arm Probes Skipped"), STAT_PracticeSpringArmProbesSkipped, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Ground Traces"), STAT_PracticeGroundTraces, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Landings"), STAT_PracticeLandings, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+
+// 이동 타이머 : FTimerManager를 사용하지 않으므로 Timer Heap 연산은 없고 이동 갱신에서 시작한 수만 센다.
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Movement Timer Starts"), STAT_PracticeMovementTimerStarts, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Buffered Jumps"), STAT_PracticeBufferedJumps, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Coyote Jumps"), STAT_PracticeCoyoteJumps, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+
+// 이동 갱신 단계(Significance)별 Pawn 수
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Significance Near Pawns"), STAT_PracticeSignificanceNear, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Significance Mid Pawns"), STAT_PracticeSignificanceMid, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Significance Far Pawns"), STAT_PracticeSignificanceFar, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+
+// 네트워크 이동
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Net Moves"), STAT_PracticeNetMoves, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Net Corrections"), STAT_PracticeNetCorrections, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Net Rejected Moves"), STAT_PracticeNetRejectedMoves, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+
+// Pawn 밀어내기
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Separation Grid Update"), STAT_PracticeSeparationGrid, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Separation Query"), STAT_PracticeSeparationQuery, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Separation Pawns"), STAT_PracticeSeparationPawns, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Separation Cell Moves"), STAT_PracticeSeparationCellMoves, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Separation Neighbor Checks"), STAT_PracticeSeparationNeighborChecks, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+
+// 움직이는 발판(Base)
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Base Movement"), STAT_PracticeBaseMovement, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Movement Bases"), STAT_PracticeMovementBases, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Based Pawns"), STAT_PracticeBasedPawns, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Based Pawn Moves"), STAT_PracticeBasedPawnMoves, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+
+// 정지 상태(Sleep)
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Sleeping Pawns"), STAT_PracticeSleepingPawns, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Awake Pawns"), STAT_PracticeAwakePawns, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pawn Wakes"), STAT_PracticePawnWakes, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+
+// 지면 높이 캐시
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ground Cache Query"), STAT_PracticeGroundCacheQuery, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Ground Cache Hits"), STAT_PracticeGroundCacheHits, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Ground Cache Misses"), STAT_PracticeGroundCacheMisses, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Ground Cache Memory"), STAT_PracticeGroundCacheMemory, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+
+// Pawn Pool
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pawn Acquire"), STAT_PracticePawnAcquire, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pawn Pool Hits"), STAT_PracticePawnPoolHits, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pawn Pool Misses"), STAT_PracticePawnPoolMisses, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pawn Pool Available"), STAT_PracticePawnPoolAvailable, STATGROUP_PracticeMovement, SPARTA_PRACTICE_7_API);
+
+// Unreal Insights 이동 구간
+// 기본으로 꺼져 있고 실행 중에 Trace.Enable PracticeMovement 혹은 -trace=cpu,PracticeMovement 로 켠다.
+// Shipping에서는 Stat, Trace 모두 제거된다.
+#if CPUPROFILERTRACE_ENABLED && !UE_BUILD_SHIPPING
+UE_TRACE_CHANNEL_EXTERN(PracticeMovementChannel, SPARTA_PRACTICE_7_API);
+#define PRACTICE_MOVEMENT_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, PracticeMovementChannel)
+#else
+#define PRACTICE_MOVEMENT_TRACE_SCOPE(Name)
+#endif
+
+// Stat Cycle Counter와 같은 이름의 Trace 구간을 함께 연다. Name은 STAT_Practice를 뺀 이름이다.
+#define PRACTICE_MOVEMENT_STAT_SCOPE(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_Practice##Name); \
+	PRACTICE_MOVEMENT_TRACE_SCOPE(Practice##Name)
@@ -0,0 +1,120 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PracticeMovementKernels.h"
+#include "PracticeMovementTypes.h"
+#include "PracticeMovementSubsystem.generated.h"
+
+class APracticeCharacter;
+
+/**
+ * APracticeCharacter의 이동을 한 번에 처리하는 Subsystem
+ * 등록된 Pawn의 이동 상태를 SoA(Structure of Arrays)로 가지고 있고, 매 프레임 한 번의 순회로 모든 Pawn을 갱신한다.
+ * 등록된 Pawn은 개별 Tick을 사용하지 않는다.
+ * 같은 입력이면 개별 Tick과 같은 결과를 낸다. (자동화 테스트 Practice.Movement.Batched.MatchesActorTick)
+ * 개별 Tick과 의도적으로 다른 점
+ * - 튜닝 값(FPracticeMovementParams)은 RegisterPawn에서 한 번 복사하므로 이후에 Blueprint나 UPROPERTY에서 바꾼 값은 반영되지 않는다.
+ * - 고정 시간 간격(bUseFixedTimestep)과 Sleep을 사용하지 않는다.
+ */
+UCLASS()
+class SPARTA_PRACTICE_7_API UPracticeMovementSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// 등록 시점의 Pawn 상태와 튜닝 값을 복사해서 가져온다. 반환값은 배열 Index
+	int32 RegisterPawn(APracticeCharacter* Pawn);
+	void UnregisterPawn(APracticeCharacter* Pawn);
+
+	void SetInputDirection(int32 Index, const FVector2D& NewInputDirection);
+	void RequestJump(int32 Index);
+	void RequestToggleDrone(int32 Index);
+	// TickInterval이 0보다 크면 그 간격마다 누적된 시간으로 한 번 갱신한다.
+	void SetSignificance(int32 Index, EPracticeSignificance NewSignificance, float TickInterval);
+
+	int32 GetNumPawns() const { return Pawns.Num(); }
+
+	// 개별 Tick 경로의 비용을 비교하기 위해서 Pawn의 Tick 시간을 누적한다.
+	void AddActorTickTime(double Seconds);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// Game Thread : Controller 회전 갱신, Actor 상태 읽기
+	void Gather(int32 Index, float DeltaTime);
+	// Worker Thread : [Begin, End) 구간을 Integrate → 속력, 낙하 속도 계산 → 이동량 순서로 처리
+	void IntegrateRange(int32 Begin, int32 End, bool bUseKernels, bool bValidateKernels);
+	// 점프, 입력 방향, 회전을 계산하고 속력, 낙하 속도 계산에 사용할 Lane을 채운다.
+	void Integrate(int32 Index);
+	// Lane의 속력, 낙하 속도, 공중 이동 방향을 SIMD로 계산한다.
+	void IntegrateLanes(int32 Begin, int32 End);
+	// IntegrateLanes의 한 Pawn을 PracticeMovement의 Scalar 함수로 계산한다.
+	void IntegrateLaneScalar(int32 Index, float& OutVelocity, float& OutFallSpeed, FVector& OutMoveDirection) const;
+	// 이번 프레임 이동량
+	void UpdateDelta(int32 Index);
+#if !UE_BUILD_SHIPPING
+	// SIMD 계산 결과를 Scalar 함수 결과와 비교한다.
+	void IntegrateLanesValidated(int32 Begin, int32 End);
+#endif
+	// Game Thread : 회전 적용, Sweep 이동, 착지 판정
+	void Commit(int32 Index);
+	// Game Thread : 이동 후 상태 시간, 이동 타이머 갱신
+	void TickMovementMode(int32 Index, float DeltaTime);
+	// Game Thread : 이동 후 이벤트. 보관한 점프가 처리되면 회전을 바로 적용한다.
+	void HandleEventAfterMove(int32 Index, EPracticeMovementEvent Event);
+	void HandleEvent(int32 Index, EPracticeMovementEvent Event);
+	// ABP 등에서 읽을 수 있도록 Pawn의 UPROPERTY에 상태를 복사한다.
+	void WriteBack(int32 Index);
+	// Pawn에서 직접 상태를 바꾼 경우 다시 가져온다.
+	void ReadBack(int32 Index);
+	void PublishStats(double BatchedSeconds);
+
+	// SoA 이동 상태
+	// 모든 배열은 같은 Index가 같은 Pawn을 가리킨다.
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<APracticeCharacter>> Pawns;
+
+	TArray<FVector2D> InputDirection;
+	TArray<float> Velocity;
+	TArray<FVector> MoveDirection;
+	TArray<float> FallSpeed;
+	TArray<EPracticeMovementMode> MovementMode;
+	TArray<float> StateTimeRemaining;
+	TArray<FPracticeMovementTimers> MovementTimers;
+	TArray<uint8> StateFlags;
+	TArray<FPracticeMovementParams> Params;
+	FPracticeMovementParamLanes ParamLanes;
+	TArray<EPracticeSignificance> Significance;
+	TArray<float> TickInterval;
+	TArray<float> AccumulatedTime;
+
+	// 프레임마다 다시 채우는 중간 결과
+	// StepTime : 이번 갱신에서 사용할 시간, 갱신 간격이 있으면 누적된 시간이다.
+	TArray<float> StepTime;
+	TArray<float> ControlYaw;
+	TArray<float> JumpYaw;
+	// 지상 이동의 회전은 Yaw만 사용한다.
+	TArray<float> ActorYaw;
+	TArray<float> TargetYaw;
+	// Lane : 0보다 크면 이번 프레임에 해당 이동을 계산한다.
+	TArray<float> GroundLane;
+	TArray<float> AirLane;
+	TArray<float> TargetVelocity;
+	// 공중 이동의 최대 속도 제한 전 속도, 계산 후에는 이동 방향
+	TArray<float> AirSpeedX;
+	TArray<float> AirSpeedY;
+	TArray<float> AirSpeedZ;
+	TArray<FVector> HorizontalDelta;
+	TArray<FVector> VerticalDelta;
+
+	double ActorTickSeconds = 0.0;
+	int32 ActorTickCount = 0;
+};
@@ -0,0 +1,399 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PracticeMovementTypes.generated.h"
+
+// 이동 상태
+// 한 번에 하나의 상태만 가진다. 상태 전이는 PracticeMovement::TransitionTable을 따른다.
+UENUM(BlueprintType)
+enum class EPracticeMovementMode : uint8
+{
+	Walking,
+	Jumping,
+	Falling,
+	// 착지 후 LandingLockTime 동안 점프할 수 없다.
+	Landing,
+	Drone,
+	MAX UMETA(Hidden)
+};
+
+// 카메라와의 거리, 가시성에 따른 이동 갱신 단계
+UENUM(BlueprintType)
+enum class EPracticeSignificance : uint8
+{
+	// 매 프레임 전체 이동
+	Near,
+	// 낮은 빈도로 전체 이동, 사이 시간은 누적해서 사용
+	Mid,
+	// 낮은 빈도로 지상에서는 Sweep 없이 이동
+	Far,
+	MAX UMETA(Hidden)
+};
+
+// 상태 전이를 일으키는 이벤트
+enum class EPracticeMovementEvent : uint8
+{
+	// 점프 입력
+	Jump,
+	// 이동 후 지면이 없다.
+	LeaveGround,
+	// 이동 후 지면과 충돌
+	Land,
+	// 상태의 남은 시간이 끝났다.
+	Timeout,
+	// 드론 모드 전환
+	ToggleDrone,
+	MAX
+};
+
+// 상태와 별개로 동작하는 짧은 이동 타이머
+enum class EPracticeMovementTimer : uint8
+{
+	// 점프할 수 없는 상태에서 받은 점프 입력을 JumpBufferTime 동안 보관한다.
+	JumpBuffer,
+	// 지면에서 떨어진 뒤 CoyoteTime 동안은 점프할 수 있다.
+	Coyote,
+	MAX
+};
+
+// Pawn별 이동 타이머
+// FTimerManager 대신 이동 갱신에서 DeltaTime만큼 줄인다. Timer Heap 연산과 Delegate 호출이 없다.
+// 상태에 묶인 시간(착지 잠금)은 StateTimeRemaining을 사용한다.
+struct FPracticeMovementTimers
+{
+	float Remaining[static_cast<int32>(EPracticeMovementTimer::MAX)] = {};
+
+	// Duration이 0 이하면 시작하지 않는다.
+	FORCEINLINE void Start(const EPracticeMovementTimer Timer, const float Duration)
+	{
+		Remaining[static_cast<int32>(Timer)] = FMath::Max(Duration, 0.0f);
+	}
+
+	FORCEINLINE void Clear(const EPracticeMovementTimer Timer)
+	{
+		Remaining[static_cast<int32>(Timer)] = 0.0f;
+	}
+
+	FORCEINLINE bool IsActive(const EPracticeMovementTimer Timer) const
+	{
+		return Remaining[static_cast<int32>(Timer)] > 0.0f;
+	}
+
+	FORCEINLINE void Tick(const float DeltaTime)
+	{
+		for (float& Time : Remaining)
+		{
+			Time = FMath::Max(Time - DeltaTime, 0.0f);
+		}
+	}
+
+	// Hold 타이머는 줄이지 않는다.
+	FORCEINLINE void Tick(const float DeltaTime, const EPracticeMovementTimer Hold)
+	{
+		const float HoldRemaining = Remaining[static_cast<int32>(Hold)];
+		Tick(DeltaTime);
+		Remaining[static_cast<int32>(Hold)] = HoldRemaining;
+	}
+
+	FORCEINLINE void Reset()
+	{
+		*this = FPracticeMovementTimers();
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FPracticeMovementTimers& Timers)
+	{
+		for (float& Time : Timers.Remaining)
+		{
+			Ar << Time;
+		}
+		return Ar;
+	}
+};
+
+// 이동 계산에 필요한 튜닝 값
+// APracticeCharacter의 UPROPERTY 값을 복사해서 사용한다.
+struct FPracticeMovementParams
+{
+	float MoveSpeed = 600.0f;
+	float AccelDamp = 20.0f;
+	float TurnSmoothingDamp = 5.0f;
+	float JumpVelocity = 500.0f;
+	float MaxJumpHorizontalVelocity = 200.0f;
+	float FallMultiplier = 1.5f;
+	float TerminalSpeed = -2500.0f;
+	float LandingLockTime = 0.1f;
+	float JumpBufferTime = 0.0f;
+	float CoyoteTime = 0.0f;
+	float Gravity = -981.0f;
+	float AirSpeedMultiplier = 0.2f;
+};
+
+// 이동 상태 전체, 입력 재생의 시작 상태와 결과 비교에 사용한다.
+struct FPracticeMovementSnapshot
+{
+	FVector Location = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+	FRotator ControlRotation = FRotator::ZeroRotator;
+	float Velocity = 0.0f;
+	FVector MoveDirection = FVector::ZeroVector;
+	float FallSpeed = 0.0f;
+	EPracticeMovementMode MovementMode = EPracticeMovementMode::Walking;
+	float StateTimeRemaining = 0.0f;
+	FPracticeMovementTimers MovementTimers;
+	FVector DroneVelocity = FVector::ZeroVector;
+
+	friend FArchive& operator<<(FArchive& Ar, FPracticeMovementSnapshot& Snapshot)
+	{
+		Ar << Snapshot.Location << Snapshot.Rotation << Snapshot.ControlRotation;
+		Ar << Snapshot.Velocity << Snapshot.MoveDirection << Snapshot.FallSpeed;
+		Ar << Snapshot.MovementMode << Snapshot.StateTimeRemaining << Snapshot.MovementTimers << Snapshot.DroneVelocity;
+		return Ar;
+	}
+
+	// 모든 값이 비트 단위로 같은지 비교한다.
+	bool IsBitwiseEqual(const FPracticeMovementSnapshot& Other) const
+	{
+		const auto Equal = [](const auto& A, const auto& B) { return FMemory::Memcmp(&A, &B, sizeof(A)) == 0; };
+		return Equal(Location, Other.Location) && Equal(Rotation, Other.Rotation) && Equal(ControlRotation, Other.ControlRotation)
+			&& Equal(Velocity, Other.Velocity) && Equal(MoveDirection, Other.MoveDirection) && Equal(FallSpeed, Other.FallSpeed)
+			&& MovementMode == Other.MovementMode && Equal(StateTimeRemaining, Other.StateTimeRemaining)
+			&& Equal(MovementTimers.Remaining, Other.MovementTimers.Remaining) && Equal(DroneVelocity, Other.DroneVelocity);
+	}
+};
+
+// 배치 처리에서 사용하는 프레임 플래그
+namespace EPracticeMovementFlags
+{
+	enum Type : uint8
+	{
+		None			= 0,
+		JumpRequested	= 1 << 0,
+		// 이번 프레임에 Commit 단계에서 회전을 적용해야 한다.
+		RotationDirty	= 1 << 1,
+		// Controller가 없어서 이번 프레임은 처리하지 않는다.
+		Inactive		= 1 << 2,
+		DroneToggleRequested	= 1 << 3,
+	};
+}
+
+// Move의 Sweep 결과
+enum class EPracticeSweepResult : uint8
+{
+	// 지면과 충돌
+	Ground,
+	// 벽과 충돌
+	Wall,
+	// 충돌하지 않았고 지면도 없다.
+	Air,
+};
+
+// Controller Yaw 기준의 전방 / 오른쪽 벡터
+// 한 번의 SinCos로 구하고 같은 프레임 동안 이동 계산에서 재사용한다.
+struct FPracticeYawBasis
+{
+	float Yaw = 0.0f;
+	FVector Forward = FVector::ForwardVector;
+	FVector Right = FVector::RightVector;
+
+	FPracticeYawBasis() = default;
+
+	explicit FPracticeYawBasis(const float InYaw)
+		: Yaw(InYaw)
+	{
+		float Sin, Cos;
+		FMath::SinCos(&Sin, &Cos, FMath::DegreesToRadians(InYaw));
+		Forward = FVector(Cos, Sin, 0.0f);
+		Right = FVector(-Sin, Cos, 0.0f);
+	}
+
+	// 입력 방향(X : Forward, Y : Right)을 정규화된 월드 벡터로 변환한다.
+	FORCEINLINE FVector ToWorld(const FVector2D& InputDirection) const
+	{
+		return (Forward * InputDirection.X + Right * InputDirection.Y).GetSafeNormal();
+	}
+};
+
+// 이동 계산 함수
+// Actor의 상태를 읽지 않는 순수 계산만 모아둔다.
+// 개별 Tick과 배치 처리가 같은 함수를 사용하므로 두 경로의 결과가 같다.
+namespace PracticeMovement
+{
+	using enum EPracticeMovementMode;
+
+	// 상태 전이 표 : [현재 상태][이벤트] = 다음 상태
+	// 현재 상태와 같으면 전이하지 않는다.
+	inline constexpr EPracticeMovementMode TransitionTable[static_cast<int32>(EPracticeMovementMode::MAX)][static_cast<int32>(EPracticeMovementEvent::MAX)] =
+	{
+		//				Jump		LeaveGround		Land		Timeout		ToggleDrone
+		/* Walking */ {	Jumping,	Falling,		Walking,	Walking,	Drone },
+		/* Jumping */ {	Jumping,	Jumping,		Landing,	Jumping,	Drone },
+		/* Falling */ {	Falling,	Falling,		Landing,	Falling,	Drone },
+		/* Landing */ {	Landing,	Falling,		Landing,	Walking,	Drone },
+		/* Drone   */ {	Drone,		Drone,			Drone,		Drone,		Falling },
+	};
+
+	FORCEINLINE EPracticeMovementMode GetNextMode(const EPracticeMovementMode Mode, const EPracticeMovementEvent Event)
+	{
+		return TransitionTable[static_cast<int32>(Mode)][static_cast<int32>(Event)];
+	}
+
+	// 상태의 남은 시간을 줄이고 끝났으면 true를 반환한다.
+	// 이전의 FTimerManager Timer와 같이 남은 시간이 프레임 간격의 배수이면 float 오차가 남아도 그 프레임에 끝낸다.
+	FORCEINLINE bool TickStateTime(float& StateTimeRemaining, const float DeltaTime)
+	{
+		if (StateTimeRemaining <= 0.0f)
+		{
+			return false;
+		}
+		StateTimeRemaining -= DeltaTime;
+		return StateTimeRemaining <= UE_KINDA_SMALL_NUMBER;
+	}
+
+	// 이동 타이머를 줄인다.
+	// 착지 잠금 중에는 Jump Buffer를 줄이지 않는다. 공중에서 보관한 점프가 잠금이 끝날 때까지 남아 있어야
+	// Walking에 들어갈 때 다시 처리된다. (JumpBufferTime이 LandingLockTime 이하여도 보관한 점프가 사라지지 않는다.)
+	FORCEINLINE void TickMovementTimers(FPracticeMovementTimers& Timers, const EPracticeMovementMode Mode, const float DeltaTime)
+	{
+		if (Mode == Landing)
+		{
+			Timers.Tick(DeltaTime, EPracticeMovementTimer::JumpBuffer);
+		}
+		else
+		{
+			Timers.Tick(DeltaTime);
+		}
+	}
+
+	// 지면 이동(PlaneMove)을 사용하는 상태
+	FORCEINLINE bool IsGroundMode(const EPracticeMovementMode Mode)
+	{
+		return Mode == EPracticeMovementMode::Walking || Mode == EPracticeMovementMode::Landing;
+	}
+
+	// 점프 이벤트의 다음 상태
+	// 전이 표에서 점프할 수 없으면 Coyote Time 안의 낙하는 점프하고, 그 외에는 입력을 Jump Buffer에 보관한다.
+	// 보관한 입력은 Walking 상태에 들어갈 때 다시 점프 이벤트로 처리한다.
+	FORCEINLINE EPracticeMovementMode ResolveJump(const EPracticeMovementMode Mode, FPracticeMovementTimers& Timers, const FPracticeMovementParams& Params)
+	{
+		const EPracticeMovementMode NextMode = GetNextMode(Mode, EPracticeMovementEvent::Jump);
+		if (NextMode != Mode)
+		{
+			return NextMode;
+		}
+
+		if (Mode == Falling && Timers.IsActive(EPracticeMovementTimer::Coyote))
+		{
+			return Jumping;
+		}
+
+		if (Mode != Drone)
+		{
+			Timers.Start(EPracticeMovementTimer::JumpBuffer, Params.JumpBufferTime);
+		}
+		return Mode;
+	}
+
+	FORCEINLINE float CalculateVelocity(const float CurrentVelocity, const float TargetVelocity, const float AccelDamp, const float DeltaTime)
+	{
+		if (FMath::IsNearlyEqual(TargetVelocity, CurrentVelocity))
+		{
+			return TargetVelocity;
+		}
+
+		const float Alpha = FMath::Clamp(DeltaTime * AccelDamp, 0.f, 1.f);
+		return FMath::Lerp(CurrentVelocity, TargetVelocity, Alpha);
+	}
+
+	FORCEINLINE float UpdateFallSpeed(float FallSpeed, const float Gravity, const float FallMultiplier, const float TerminalSpeed, const float DeltaTime)
+	{
+		if (FallSpeed >= 0)
+		{
+			FallSpeed += Gravity * DeltaTime;
+		}
+		else if (FallSpeed > TerminalSpeed)
+		{
+			FallSpeed += Gravity * DeltaTime * FallMultiplier;
+			FallSpeed = FallSpeed > TerminalSpeed ? FallSpeed : TerminalSpeed;
+		}
+		return FallSpeed;
+	}
+
+	FORCEINLINE float UpdateFallSpeed(const float FallSpeed, const FPracticeMovementParams& Params, const float DeltaTime)
+	{
+		return UpdateFallSpeed(FallSpeed, Params.Gravity, Params.FallMultiplier, Params.TerminalSpeed, DeltaTime);
+	}
+
+	// Controller의 Yaw를 기준으로 입력 방향을 월드 벡터로 변환한다. 월드 벡터는 정규화되어 있다.
+	// 같은 Yaw를 여러 번 사용하면 FPracticeYawBasis를 만들어서 재사용한다.
+	FORCEINLINE FVector GetMoveDirection(const float ControllerYaw, const FVector2D& InputDirection)
+	{
+		return FPracticeYawBasis(ControllerYaw).ToWorld(InputDirection);
+	}
+
+	// 이동 방향을 바라보는 Yaw. 지상 이동은 Pitch, Roll을 사용하지 않는다.
+	FORCEINLINE float GetFaceYaw(const FVector& Direction)
+	{
+		return FMath::RadiansToDegrees(FMath::Atan2(Direction.Y, Direction.X));
+	}
+
+	FORCEINLINE FRotator GetFaceRotation(const FVector& Direction)
+	{
+		return FRotator(0.0f, GetFaceYaw(Direction), 0.0f);
+	}
+
+	// Yaw만 사용하는 FMath::RInterpTo
+	FORCEINLINE float InterpYawTo(const float CurrentYaw, const float TargetYaw, const float DeltaTime, const float InterpSpeed)
+	{
+		if (InterpSpeed <= 0.0f)
+		{
+			return TargetYaw;
+		}
+
+		const float DeltaYaw = FRotator::NormalizeAxis(TargetYaw - CurrentYaw);
+		if (FMath::Abs(DeltaYaw) <= KINDA_SMALL_NUMBER)
+		{
+			return TargetYaw;
+		}
+		return FRotator::NormalizeAxis(CurrentYaw + DeltaYaw * FMath::Clamp(DeltaTime * InterpSpeed, 0.0f, 1.0f));
+	}
+
+	// Z축 회전만 있는 Quaternion, Rotator를 거치지 않고 바로 만든다.
+	FORCEINLINE FQuat MakeYawQuat(const float Yaw)
+	{
+		float Sin, Cos;
+		FMath::SinCos(&Sin, &Cos, FMath::DegreesToRadians(Yaw) * 0.5f);
+		return FQuat(0.0f, 0.0f, Sin, Cos);
+	}
+
+	// 공중 이동 : 현재 속도에 입력 방향의 가속도를 더한 속도. 최대 속도 제한 전의 값이다.
+	FORCEINLINE FVector GetAirSpeed(const float Velocity, const FVector& MoveDirection, const FVector& InputWorldDirection, const FPracticeMovementParams& Params, const float DeltaTime)
+	{
+		const FVector CurrentSpeed = Velocity * MoveDirection;
+
+		float AccelAmount = Params.MoveSpeed * Params.AirSpeedMultiplier * DeltaTime;
+		AccelAmount = FMath::Clamp(AccelAmount, 0.f, Params.MoveSpeed * DeltaTime);
+		const FVector Acceleration = InputWorldDirection * AccelAmount;
+
+		return CurrentSpeed + Acceleration;
+	}
+
+	// 속도가 최대 속도를 넘지 않도록 제한하고 속력과 방향으로 나눈다.
+	FORCEINLINE void ClampAirSpeed(FVector NewSpeed, const float MaxSpeed, float& Velocity, FVector& MoveDirection)
+	{
+		if (NewSpeed.Length() > MaxSpeed)
+		{
+			NewSpeed = NewSpeed.GetSafeNormal() * MaxSpeed;
+		}
+		MoveDirection = NewSpeed.GetSafeNormal();
+		Velocity = NewSpeed.Length();
+	}
+
+	// 공중 이동
+	// 현재 속도에 입력 방향의 가속도를 더하고 최대 속도를 넘지 않도록 제한한다.
+	FORCEINLINE void AirAccelerate(float& Velocity, FVector& MoveDirection, const FVector& InputWorldDirection, const FPracticeMovementParams& Params, const float DeltaTime)
+	{
+		ClampAirSpeed(GetAirSpeed(Velocity, MoveDirection, InputWorldDirection, Params, DeltaTime), Params.MoveSpeed, Velocity, MoveDirection);
+	}
+}
@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "PracticeMovingPlatform.generated.h"
+
+/**
+ * 움직이는 발판 예제
+ * 시작 위치에서 Travel만큼 왕복하면서 YawSpeed로 회전한다. Sweep 없이 Transform만 바꾸고, 위에 있는 APracticeCharacter는
+ * UPracticeMovementBaseSubsystem이 함께 옮긴다.
+ * 움직이는 범위는 지면 높이 캐시에서 물리 Trace를 사용하도록 표시한다.
+ * 서버에서만 움직이고 Client에는 이동을 복제한다.
+ *
+ * 콘솔 명령
+ * practice.SpawnPlatform [X] [Y] [Z] [주기]	: 플레이어 앞에 발판을 만든다. 이동량(cm), 왕복 주기(초)
+ * practice.ClearPlatforms						: practice.SpawnPlatform으로 만든 발판을 모두 제거한다.
+ */
+UCLASS()
+class SPARTA_PRACTICE_7_API APracticeMovingPlatform : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	APracticeMovingPlatform();
+
+	virtual void Tick(float DeltaTime) override;
+
+	// 시작 위치에서 가장 멀리 이동하는 거리
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Platform")
+	FVector Travel;
+
+	// 왕복 한 번의 시간(초)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Platform", meta = (ClampMin = "0.1"))
+	float Period;
+
+	// 0 ~ 1, 같은 주기의 발판이 서로 다른 위치에서 시작하도록 한다.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Platform", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float PhaseOffset;
+
+	// 초당 Yaw 회전 각도
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Platform")
+	float YawSpeed;
+
+	static void SpawnPlatforms(const TArray<FString>& Args, UWorld* World);
+	static void ClearPlatforms(UWorld* World);
+
+protected:
+	virtual void BeginPlay() override;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Platform")
+	TObjectPtr<class UStaticMeshComponent> MeshComponent;
+
+private:
+	FVector StartLocation = FVector::ZeroVector;
+	FRotator StartRotation = FRotator::ZeroRotator;
+	float ElapsedTime = 0.0f;
+
+	// practice.SpawnPlatform으로 만든 발판, practice.ClearPlatforms에서 제거한다.
+	bool bSpawnedByCommand = false;
+};
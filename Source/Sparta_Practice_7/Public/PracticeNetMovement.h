@@ -0,0 +1,123 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+#include "PracticeMovementTypes.h"
+#include "PracticeNetMovement.generated.h"
+
+/**
+ * 클라이언트가 서버로 보내는 이동 입력 하나
+ * 클라이언트는 양자화한 값으로 직접 예측하므로 서버와 같은 입력으로 시뮬레이션한다.
+ */
+USTRUCT()
+struct SPARTA_PRACTICE_7_API FPracticeNetMove
+{
+	GENERATED_BODY()
+
+	enum EFlags : uint8
+	{
+		Jump		= 1 << 0,
+		DroneToggle	= 1 << 1,
+		// 아래 값이 0이 아닐 때만 보낸다.
+		HasRoll		= 1 << 2,
+		HasThrust	= 1 << 3,
+	};
+
+	// 클라이언트 시간(ms), DeltaTimeMs의 누적
+	uint32 TimeStamp = 0;
+	uint8 DeltaTimeMs = 0;
+	// 이동 입력 [-127, 127]
+	int8 MoveX = 0;
+	int8 MoveY = 0;
+	// Controller 회전 (FRotator::CompressAxisToShort)
+	uint16 Pitch = 0;
+	uint16 Yaw = 0;
+	uint16 Roll = 0;
+	// 드론 상승 입력 [-127, 127]
+	int8 Thrust = 0;
+	uint8 Flags = 0;
+
+	// 한 번에 보낼 수 있는 최대 시간
+	static constexpr uint8 MaxDeltaTimeMs = 250;
+
+	void SetMoveInput(const FVector2D& MoveInput);
+	void SetControlRotation(const FRotator& ControlRotation);
+	void SetDroneThrust(float DroneThrustInput);
+
+	float GetDeltaTime() const { return DeltaTimeMs * 0.001f; }
+	FVector2D GetMoveInput() const { return FVector2D(MoveX / 127.0f, MoveY / 127.0f); }
+	FRotator GetControlRotation() const;
+	float GetDroneThrust() const { return Thrust / 127.0f; }
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FPracticeNetMove> : public TStructOpsTypeTraitsBase2<FPracticeNetMove>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+/**
+ * 서버 결과와 클라이언트 예측이 다를 때 보내는 서버 상태
+ */
+USTRUCT()
+struct SPARTA_PRACTICE_7_API FPracticeNetCorrection
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	uint32 TimeStamp = 0;
+
+	UPROPERTY()
+	FVector_NetQuantize100 Location;
+
+	UPROPERTY()
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	UPROPERTY()
+	float Velocity = 0.0f;
+
+	UPROPERTY()
+	FVector_NetQuantizeNormal MoveDirection;
+
+	UPROPERTY()
+	float FallSpeed = 0.0f;
+
+	UPROPERTY()
+	EPracticeMovementMode MovementMode = EPracticeMovementMode::Walking;
+
+	UPROPERTY()
+	float StateTimeRemaining = 0.0f;
+
+	UPROPERTY()
+	FVector_NetQuantize10 DroneVelocity;
+};
+
+/**
+ * 다른 클라이언트(Simulated Proxy)에서 보여주기 위한 이동 상태
+ */
+USTRUCT()
+struct SPARTA_PRACTICE_7_API FPracticeRepMovement
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector_NetQuantize100 Location;
+
+	// 지상 이동은 Yaw만 사용하지만 드론은 Pitch, Roll도 사용한다.
+	UPROPERTY()
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	// Animation에서 사용하는 수평 속력
+	UPROPERTY()
+	float Velocity = 0.0f;
+
+	UPROPERTY()
+	EPracticeMovementMode MovementMode = EPracticeMovementMode::Walking;
+};
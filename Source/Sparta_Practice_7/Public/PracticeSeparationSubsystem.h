@@ -0,0 +1,73 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PracticeSeparationSubsystem.generated.h"
+
+class APracticeCharacter;
+
+// 밀려나는 Pawn의 Object Type (DefaultEngine.ini의 PracticeCrowd 채널)
+// 같은 채널끼리는 무시하고, Pawn 채널(플레이어 Pawn)과 다른 물체는 막는다.
+#define ECC_PracticeCrowd ECC_GameTraceChannel1
+
+/**
+ * APracticeCharacter 사이의 밀어내기(Separation)를 처리하는 Subsystem
+ * Pawn끼리는 이동 Sweep에서 충돌하지 않고, 균일 격자(Spatial Hash)로 가까운 Pawn을 찾아서 겹친 만큼 밀어내는 속도를 계산한다.
+ * 높이 차이가 두 Capsule 반 높이의 합보다 크면(다른 층, 발판 위, 점프 중) 밀어내지 않는다.
+ * Pawn은 다음 이동에서 이 속도를 수평 이동량에 더한다. 서버에서만 계산하고 클라이언트가 조종하는 Pawn은 밀려나지 않는다.
+ * 플레이어가 조종하는 Pawn은 밀려나지 않고 Pawn 채널로 남아서 다른 Pawn과 Sweep으로 막힌다. 다른 Pawn만 밀어낸다.
+ * 격자는 매 프레임 셀이 바뀐 Pawn만 옮긴다. 설정은 practice.Separation.* CVar로 조정한다.
+ */
+UCLASS()
+class SPARTA_PRACTICE_7_API UPracticeSeparationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// 밀려나는 Pawn은 Object Type을 ECC_PracticeCrowd로 바꾸고, 등록을 해제하면 원래 설정으로 되돌린다.
+	// 예측 이동의 충돌이 서버와 같도록 클라이언트에서도 등록한다. practice.Separation.Enable이 0이면 등록하지 않는다.
+	void RegisterPawn(APracticeCharacter* Pawn);
+	void UnregisterPawn(APracticeCharacter* Pawn);
+	// 플레이어 조종 여부(PlayerState)가 바뀌면 충돌 설정을 다시 정한다.
+	void UpdatePawnCollision(APracticeCharacter* Pawn);
+
+	// 이번 프레임에 적용할 밀어내기 속도(수평)
+	FVector GetSeparationVelocity(int32 Index) const { return SeparationVelocity.IsValidIndex(Index) ? SeparationVelocity[Index] : FVector::ZeroVector; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	FIntPoint GetCell(const FVector& Location) const;
+	void AddToCell(int32 Index, const FIntPoint& Cell);
+	void RemoveFromCell(int32 Index, const FIntPoint& Cell);
+	// 셀 크기가 바뀌면 전체를 다시 만든다.
+	void RebuildAll();
+	// 위치를 갱신하고 셀이 바뀐 Pawn만 옮긴다.
+	void UpdateGrid();
+	void UpdateSeparation();
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<APracticeCharacter>> Pawns;
+
+	// Pawns와 같은 Index
+	TArray<FVector> Location;
+	TArray<float> Radius;
+	TArray<float> HalfHeight;
+	TArray<FIntPoint> PawnCell;
+	TArray<FVector> SeparationVelocity;
+	// 등록 전의 Object Type, ECC_PracticeCrowd 채널 설정
+	TArray<TEnumAsByte<ECollisionChannel>> ObjectType;
+	TArray<TEnumAsByte<ECollisionResponse>> CrowdResponse;
+
+	// 셀마다 들어 있는 Pawn Index, 빈 셀은 지운다.
+	TMap<FIntPoint, TArray<int32>> Cells;
+	float CellSize = 0.0f;
+};
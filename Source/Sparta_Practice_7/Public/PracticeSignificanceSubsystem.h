@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PracticeMovementTypes.h"
+#include "PracticeSignificanceSubsystem.generated.h"
+
+class APracticeCharacter;
+
+/**
+ * APracticeCharacter의 이동 갱신 단계(Significance)를 결정하는 Subsystem
+ * 로컬 플레이어 카메라와의 거리로 Near / Mid / Far를 나누고, 화면 밖에 있으면 한 단계 낮춘다.
+ * 단계가 바뀔 때만 Pawn에 전달하고, 거리 기준과 갱신 간격은 practice.Significance.* CVar로 조정한다.
+ */
+UCLASS()
+class SPARTA_PRACTICE_7_API UPracticeSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterPawn(APracticeCharacter* Pawn);
+	void UnregisterPawn(APracticeCharacter* Pawn);
+
+	// 단계별 이동 갱신 간격(초), 0이면 매 프레임
+	static float GetTickInterval(EPracticeSignificance Significance);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// 로컬 플레이어의 카메라 위치, 방향, 시야각(절반)의 cos
+	bool GetViewPoint(FVector& OutLocation, FVector& OutForward, float& OutHalfFOVCos, const APawn*& OutLocalPawn) const;
+	void UpdateSignificance();
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<APracticeCharacter>> Pawns;
+
+	float TimeSinceUpdate = 0.0f;
+	int32 NumPawnsPerBucket[static_cast<int32>(EPracticeSignificance::MAX)] = {};
+};
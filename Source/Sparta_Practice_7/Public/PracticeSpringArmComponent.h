@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/SpringArmComponent.h"
+#include "PracticeSpringArmComponent.generated.h"
+
+/**
+ * 충돌 검사(Probe)를 줄인 Spring Arm
+ * 막혀 있지 않을 때는 ProbeSize에 ClearMargin을 더한 구로 한 번 검사하고, Arm의 시작점과 끝점이 ClearMargin 안에서 움직이는 동안은 검사하지 않는다.
+ * 두 끝점이 모두 ClearMargin 안에 있으면 ProbeSize 구로 검사할 영역은 이전 검사 영역 안에 있으므로 정적인 지형에 대해서는 결과가 같다.
+ * 여유를 둔 검사에서 막히면 MaxSkippedProbes 프레임 동안 원래 크기로만 검사한다.
+ * 움직이는 물체를 위해 MaxSkippedProbes 프레임마다 다시 검사하고, Camera Lag을 사용하면 매 프레임 검사한다.
+ */
+UCLASS(ClassGroup = Camera, meta = (BlueprintSpawnableComponent))
+class SPARTA_PRACTICE_7_API UPracticeSpringArmComponent : public USpringArmComponent
+{
+	GENERATED_BODY()
+
+public:
+	UPracticeSpringArmComponent();
+
+	// Component Tick 대신 Camera Manager에서 프레임 마지막에 한 번 Arm을 갱신한다.
+	void UpdateArm(float DeltaTime);
+
+	// 막혀 있지 않은 검사 결과를 다시 사용할 수 있는 끝점의 이동 거리, 0이면 매 프레임 검사한다.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = CameraCollision, meta = (ClampMin = "0.0"))
+	float ClearMargin;
+
+	// 검사 결과를 다시 사용할 수 있는 최대 프레임 수
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = CameraCollision, meta = (ClampMin = "0"))
+	int32 MaxSkippedProbes;
+
+protected:
+	virtual void UpdateDesiredArmLocation(bool bDoTrace, bool bDoLocationLag, bool bDoRotationLag, float DeltaTime) override;
+
+private:
+	// Lag을 적용하기 전의 Arm 시작점과 끝점
+	void GetArmEnds(FVector& OutOrigin, FVector& OutEnd) const;
+
+	// 마지막으로 막혀 있지 않다고 확인한 Arm
+	bool bHasClearArm = false;
+	// 여유를 둔 검사에서 막혔다. 원래 크기의 검사가 필요하다.
+	bool bNearObstacle = false;
+	FVector ClearOrigin = FVector::ZeroVector;
+	FVector ClearEnd = FVector::ZeroVector;
+	int32 SkippedProbes = 0;
+};
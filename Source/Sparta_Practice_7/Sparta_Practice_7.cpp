@@ -3,4 +3,6 @@
 #include "Sparta_Practice_7.h"
 #include "Modules/ModuleManager.h"
 
+DEFINE_LOG_CATEGORY(LogPracticeMovement);
+
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, Sparta_Practice_7, "Sparta_Practice_7" );
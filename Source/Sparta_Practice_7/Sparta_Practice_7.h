@@ -4,3 +4,10 @@
 
 #include "CoreMinimal.h"
 
+// 이동 관련 로그, Shipping에서는 Warning 이하를 컴파일에서 제외한다.
+#if UE_BUILD_SHIPPING
+DECLARE_LOG_CATEGORY_EXTERN(LogPracticeMovement, Log, Warning);
+#else
+DECLARE_LOG_CATEGORY_EXTERN(LogPracticeMovement, Log, All);
+#endif
+